@@ -0,0 +1,215 @@
+#include "corpus_loader.h"
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <execution>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if ( fd < 0 ) {
+        throw std::runtime_error("Cannot open corpus file " + path);
+    }
+    struct stat file_stat;
+    if ( fstat(fd, &file_stat) != 0 ) {
+        close(fd);
+        throw std::runtime_error("Cannot read corpus file " + path);
+    }
+    size_ = static_cast<size_t>(file_stat.st_size);
+    if ( size_ > 0 ) {//пустой файл отобразить нельзя
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if ( data == MAP_FAILED ) {
+            close(fd);
+            throw std::runtime_error("Cannot map corpus file " + path);
+        }
+        madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(data);
+    }
+    close(fd);//отображение остаётся действительным и после закрытия дескриптора
+}
+
+MappedFile::~MappedFile() {
+    if ( data_ != nullptr ) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+}
+
+std::string_view MappedFile::GetText() const {
+    return {data_, size_};
+}
+
+namespace {
+
+struct CorpusChunk {
+    std::string_view text;
+    ParsedCorpus parsed;
+    const char* error_position = nullptr;//начало строки с ошибкой
+};
+
+bool ParseStatus(std::string_view text, DocumentStatus& status) {
+    if ( text == "ACTUAL" ) {
+        status = DocumentStatus::ACTUAL;
+    } else if ( text == "IRRELEVANT" ) {
+        status = DocumentStatus::IRRELEVANT;
+    } else if ( text == "BANNED" ) {
+        status = DocumentStatus::BANNED;
+    } else if ( text == "REMOVED" ) {
+        status = DocumentStatus::REMOVED;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+//Отрезает от line поле до табуляции
+bool TakeField(std::string_view& line, std::string_view& field) {
+    const auto tab = line.find('\t');
+    if ( tab == line.npos ) {
+        return false;
+    }
+    field = line.substr(0, tab);
+    line.remove_prefix(tab + 1);
+    return true;
+}
+
+bool ParseLine(std::string_view line, ParsedCorpus& parsed) {
+    std::string_view id_field;
+    std::string_view status_field;
+    std::string_view ratings_field;
+    if ( !TakeField(line, id_field) || !TakeField(line, status_field) || !TakeField(line, ratings_field) ) {
+        return false;
+    }
+    CorpusRecord record;
+    const auto [id_end, id_error] = std::from_chars(id_field.data(), id_field.data() + id_field.size(), record.id);
+    if ( id_error != std::errc() || id_end != id_field.data() + id_field.size() || !ParseStatus(status_field, record.status) ) {
+        return false;
+    }
+    record.ratings_begin = parsed.ratings.size();
+    const char* position = ratings_field.data();
+    const char* const ratings_end = ratings_field.data() + ratings_field.size();
+    while ( position != ratings_end ) {
+        if ( *position == ' ' ) {
+            ++position;
+            continue;
+        }
+        int rating = 0;
+        const auto [rating_end, rating_error] = std::from_chars(position, ratings_end, rating);
+        if ( rating_error != std::errc() ) {
+            return false;
+        }
+        parsed.ratings.push_back(rating);
+        position = rating_end;
+    }
+    record.ratings_end = parsed.ratings.size();
+    record.text = line;
+    parsed.records.push_back(record);
+    return true;
+}
+
+void ParseChunk(CorpusChunk& chunk) {
+    std::string_view text = chunk.text;
+    while ( !text.empty() ) {
+        const auto line_end = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, line_end);
+        text.remove_prefix(std::min(line_end + 1, text.size()));
+        if ( !line.empty() && line.back() == '\r' ) {
+            line.remove_suffix(1);
+        }
+        if ( line.empty() ) {
+            continue;
+        }
+        if ( !ParseLine(line, chunk.parsed) ) {
+            chunk.error_position = line.data();
+            return;
+        }
+    }
+}
+
+std::vector<CorpusChunk> SplitIntoChunks(std::string_view text) {
+    const size_t MIN_CHUNK_SIZE = 1 << 20;
+    const size_t chunk_count = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency() * 4, text.size() / MIN_CHUNK_SIZE));
+    const size_t chunk_size = text.size() / chunk_count + 1;
+    std::vector<CorpusChunk> chunks;
+    chunks.reserve(chunk_count);
+    while ( !text.empty() ) {//кусок продлевается до конца строки
+        const auto line_end = text.find('\n', std::min(chunk_size, text.size()) - 1);
+        const size_t size = line_end == text.npos ? text.size() : line_end + 1;
+        chunks.push_back({text.substr(0, size), {}, nullptr});
+        text.remove_prefix(size);
+    }
+    return chunks;
+}
+
+} //namespace
+
+ParsedCorpus ParseCorpus(std::string_view text) {
+    auto chunks = SplitIntoChunks(text);
+    std::for_each(std::execution::par, chunks.begin(), chunks.end(), ParseChunk);
+    
+    ParsedCorpus result;
+    for ( auto& chunk : chunks ) {
+        if ( chunk.error_position != nullptr ) {
+            const auto line_number = std::count(text.data(), chunk.error_position, '\n') + 1;
+            throw std::invalid_argument("Invalid corpus line " + std::to_string(line_number));
+        }
+        const size_t ratings_offset = result.ratings.size();
+        result.ratings.insert(result.ratings.end(), chunk.parsed.ratings.begin(), chunk.parsed.ratings.end());
+        for ( CorpusRecord record : chunk.parsed.records ) {
+            record.ratings_begin += ratings_offset;
+            record.ratings_end += ratings_offset;
+            result.records.push_back(record);
+        }
+    }
+    return result;
+}
+
+size_t LoadCorpus(const MappedFile& corpus, SearchServer& search_server) {
+    const ParsedCorpus parsed = ParseCorpus(corpus.GetText());
+    std::vector<int> ratings;//один буфер на все документы
+    for ( const CorpusRecord& record : parsed.records ) {
+        ratings.assign(parsed.ratings.begin() + record.ratings_begin, parsed.ratings.begin() + record.ratings_end);
+        search_server.AddExternalDocument(record.id, record.text, record.status, ratings);
+    }
+    return parsed.records.size();
+}
+
+size_t LoadCorpus(const MappedFile& corpus, ShardedSearchServer& search_server) {
+    const ParsedCorpus parsed = ParseCorpus(corpus.GetText());
+    //за один проход раскладываем записи по шардам, чтобы каждый шард обходил только свои
+    std::vector<std::vector<size_t>> shard_records(search_server.GetShardCount());
+    for ( size_t i = 0; i < parsed.records.size(); ++i ) {
+        if ( parsed.records[i].id < 0 ) {
+            throw std::invalid_argument("Negative id entered");
+        }
+        shard_records[search_server.GetShardIndex(parsed.records[i].id)].push_back(i);
+    }
+    //шарды независимы, поэтому заполняются параллельно
+    std::vector<size_t> shard_indexes(shard_records.size());
+    for ( size_t i = 0; i < shard_indexes.size(); ++i ) {
+        shard_indexes[i] = i;
+    }
+    std::vector<std::exception_ptr> errors(shard_indexes.size());
+    std::for_each(std::execution::par, shard_indexes.begin(), shard_indexes.end(), [&](size_t shard_index) {
+        try {//исключение из параллельного алгоритма завершило бы программу
+            std::vector<int> ratings;
+            for ( const size_t record_index : shard_records[shard_index] ) {
+                const CorpusRecord& record = parsed.records[record_index];
+                ratings.assign(parsed.ratings.begin() + record.ratings_begin, parsed.ratings.begin() + record.ratings_end);
+                search_server.AddExternalDocument(record.id, record.text, record.status, ratings);
+            }
+        } catch (...) {
+            errors[shard_index] = std::current_exception();
+        }
+    });
+    for ( const auto& error : errors ) {
+        if ( error ) {
+            std::rethrow_exception(error);
+        }
+    }
+    return parsed.records.size();
+}
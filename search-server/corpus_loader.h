@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include "document.h"
+#include "search_server.h"
+#include "sharded_search_server.h"
+
+//Файл корпуса, отображённый в память. Документы, загруженные из него, ссылаются на его текст,
+//поэтому объект должен жить дольше сервера
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    ~MappedFile();
+    
+    std::string_view GetText() const;
+    
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+//Формат строки корпуса: id<TAB>статус<TAB>рейтинги через пробел<TAB>текст,
+//статус — ACTUAL, IRRELEVANT, BANNED или REMOVED
+struct CorpusRecord {
+    int id = 0;
+    DocumentStatus status = DocumentStatus::ACTUAL;
+    std::string_view text;
+    size_t ratings_begin = 0;//рейтинги хранятся подряд в общем векторе, см. ParsedCorpus
+    size_t ratings_end = 0;
+};
+
+struct ParsedCorpus {
+    std::vector<CorpusRecord> records;
+    std::vector<int> ratings;
+};
+
+//Разбивает текст на куски по границам строк и разбирает их параллельно.
+//При ошибке разбора бросает std::invalid_argument с номером строки
+ParsedCorpus ParseCorpus(std::string_view text);
+
+//Возвращают число загруженных документов. Текст документов не копируется
+size_t LoadCorpus(const MappedFile& corpus, SearchServer& search_server);
+
+size_t LoadCorpus(const MappedFile& corpus, ShardedSearchServer& search_server);
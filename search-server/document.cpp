@@ -6,6 +6,12 @@ Document::Document(int id, double relevance, int rating)
         , rating(rating) {  
     } 
 
+bool DocumentFilter::operator()(int document_id, DocumentStatus status, int rating) const {
+    return document_id >= min_id && document_id <= max_id
+        && rating >= min_rating && rating <= max_rating
+        && (statuses.empty() || statuses.count(status) > 0);
+}
+
 std::ostream& operator<<(std::ostream& out, Document doc) {  
     return out << "{ document_id = " << doc.id << ", relevance = " << doc.relevance << ", rating = " << doc.rating << " }";  
 } 
\ No newline at end of file
@@ -1,5 +1,8 @@
 #pragma once 
 #include <iostream>
+#include <vector>
+#include <set>
+#include <limits>
 struct Document {  
     Document() = default;  
   
@@ -17,4 +20,29 @@ enum class DocumentStatus {
     REMOVED 
 }; 
  
+//Декларативный фильтр: в отличие от произвольного предиката, сервер применяет его до подсчёта релевантности
+struct DocumentFilter {
+    std::set<DocumentStatus> statuses;//пустое множество — любой статус
+    int min_rating = std::numeric_limits<int>::min();
+    int max_rating = std::numeric_limits<int>::max();
+    int min_id = 0;
+    int max_id = std::numeric_limits<int>::max();
+    
+    //позволяет использовать фильтр везде, где ожидается предикат
+    bool operator()(int document_id, DocumentStatus status, int rating) const;
+};
+
+//Позиция последнего выданного документа для постраничной выдачи
+struct PageCursor {
+    double relevance = 0.0;
+    int rating = 0;
+    int id = -1; //-1 — выдача с самого начала
+};
+
+struct DocumentsPage {
+    std::vector<Document> documents;
+    PageCursor next;//курсор для запроса следующей страницы
+    bool has_next = false;
+};
+ 
 std::ostream& operator<<(std::ostream& out, Document doc);
\ No newline at end of file
@@ -0,0 +1,26 @@
+#include "index_statistics.h"
+
+std::ostream& operator<<(std::ostream& out, const IndexStatistics& statistics) {
+    out << "documents: " << statistics.document_count
+        << ", terms: " << statistics.term_count
+        << ", postings: " << statistics.posting_count
+        << ", average document terms: " << statistics.average_document_terms
+        << ", average document bytes: " << statistics.average_document_bytes << '\n';
+    out << "bytes: word_to_document_freqs = " << statistics.word_to_document_freqs_bytes
+        << ", documents_to_word_freqs = " << statistics.documents_to_word_freqs_bytes
+        << ", documents = " << statistics.documents_bytes
+        << ", document text = " << statistics.document_text_bytes
+        << ", stop words = " << statistics.stop_words_bytes
+        << ", filter index = " << statistics.filter_index_bytes
+        << ", term dictionary = " << statistics.term_dictionary_bytes
+        << ", total = " << statistics.total_bytes << '\n';
+    out << "posting list sizes:";
+    for ( size_t i = 0; i < statistics.posting_list_histogram.size(); ++i ) {
+        out << " [" << (size_t{1} << i) << ", " << (size_t{1} << (i + 1)) << "): " << statistics.posting_list_histogram[i];
+    }
+    out << '\n' << "longest posting lists:";
+    for ( const auto& [word, size] : statistics.longest_posting_lists ) {
+        out << ' ' << word << " = " << size;
+    }
+    return out;
+}
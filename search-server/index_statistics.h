@@ -0,0 +1,32 @@
+#pragma once
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//Оценка памяти и статистика индекса. Байты считаются по структурам: узлы деревьев std::map/std::set
+//(служебные указатели + значение) и строки в куче, поэтому это нижняя оценка без учёта фрагментации
+struct IndexStatistics {
+    size_t document_count = 0;
+    size_t term_count = 0;
+    size_t posting_count = 0;
+    double average_document_terms = 0.0;//различных слов (без стоп-слов) на документ
+    double average_document_bytes = 0.0;
+    
+    size_t word_to_document_freqs_bytes = 0;
+    size_t documents_to_word_freqs_bytes = 0;
+    size_t documents_bytes = 0;
+    size_t document_text_bytes = 0;//копии текстов в DocumentData; внешние тексты не учитываются
+    size_t stop_words_bytes = 0;
+    size_t filter_index_bytes = 0;//списки по статусам и рейтингу
+    size_t term_dictionary_bytes = 0;//0, если словарь для шаблонов ещё не построен
+    size_t total_bytes = 0;
+    
+    //posting_list_histogram[i] — число слов, встречающихся в [2^i, 2^(i+1)) документах
+    std::vector<size_t> posting_list_histogram;
+    //самые длинные списки документов: слово и число документов, по убыванию.
+    //Слова скопированы, чтобы статистику можно было хранить после изменения сервера
+    std::vector<std::pair<std::string, size_t>> longest_posting_lists;
+};
+
+std::ostream& operator<<(std::ostream& out, const IndexStatistics& statistics);
@@ -18,4 +18,26 @@ std::vector<Document> ProcessQueriesJoined(
             result.insert(result.end(), document.begin(), document.end());
         }
     return result;
-    }
\ No newline at end of file
+    }
+
+std::future<std::vector<Document>> FindTopDocumentsAsync(
+    ThreadPool& pool,
+    const SearchServer& search_server,
+    std::string_view raw_query,
+    SearchServer::Deadline deadline,
+    ThreadPool::Priority priority) {
+        return FindTopDocumentsAsync(pool, search_server, raw_query, DocumentStatus::ACTUAL, deadline, priority);
+    }
+
+std::future<std::vector<Document>> FindTopDocumentsAsync(
+    ThreadPool& pool,
+    const SearchServer& search_server,
+    std::string_view raw_query,
+    DocumentStatus status,
+    SearchServer::Deadline deadline,
+    ThreadPool::Priority priority) {
+        //запрос копируем: вызывающий может освободить строку раньше, чем задача выполнится
+        return pool.Submit([&search_server, query = std::string(raw_query), status, deadline] {
+            return search_server.FindTopDocuments(query, deadline, status);
+        }, priority);
+    }
@@ -1,6 +1,7 @@
 #pragma once
 #include "search_server.h"
 #include "document.h"
+#include "thread_pool.h"
 #include <vector>
 #include <execution>
 
@@ -10,4 +11,21 @@ std::vector<std::vector<Document>> ProcessQueries(
 
 std::vector<Document> ProcessQueriesJoined(
     const SearchServer& search_server,
-    const std::vector<std::string>& queries); 
\ No newline at end of file
+    const std::vector<std::string>& queries);
+
+//Асинхронный поиск на пуле потоков. Дедлайн отсчитывается с момента постановки в очередь,
+//при переполнении очереди бросается std::runtime_error
+std::future<std::vector<Document>> FindTopDocumentsAsync(
+    ThreadPool& pool,
+    const SearchServer& search_server,
+    std::string_view raw_query,
+    SearchServer::Deadline deadline = SearchServer::Deadline::max(),
+    ThreadPool::Priority priority = ThreadPool::Priority::NORMAL);
+
+std::future<std::vector<Document>> FindTopDocumentsAsync(
+    ThreadPool& pool,
+    const SearchServer& search_server,
+    std::string_view raw_query,
+    DocumentStatus status,
+    SearchServer::Deadline deadline = SearchServer::Deadline::max(),
+    ThreadPool::Priority priority = ThreadPool::Priority::NORMAL);
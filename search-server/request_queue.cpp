@@ -10,9 +10,7 @@
  
      
     std::vector<Document> RequestQueue::AddFindRequest(const std::string& raw_query, DocumentStatus status) { 
-         return AddFindRequest(raw_query, [status](int document_id, DocumentStatus document_status, int rating) { 
-            return document_status == status; 
-            }); 
+         return AddFindRequest(raw_query, DocumentFilter{{status}}); 
     } 
      
     std::vector<Document> RequestQueue::AddFindRequest(const std::string& raw_query) { 
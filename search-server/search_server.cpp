@@ -1,4 +1,19 @@
 #include "search_server.h"  
+#include <queue>
+
+namespace {
+//узел красно-чёрного дерева: цвет и три указателя плюс хранимое значение
+template <typename Container>
+size_t TreeNodeBytes() {
+    return 4 * sizeof(void*) + sizeof(typename Container::value_type);
+}
+
+size_t StringHeapBytes(const std::string& str) {
+    const char* object = reinterpret_cast<const char*>(&str);
+    const bool is_local = str.data() >= object && str.data() < object + sizeof(str);//короткая строка живёт внутри объекта
+    return is_local ? 0 : str.capacity() + 1;
+}
+} //namespace
   
 SearchServer::SearchServer(const std::string& stop_words_text)   
         : SearchServer::SearchServer(   
@@ -13,6 +28,14 @@ SearchServer::SearchServer(std::string_view stop_words_text)
     }
  //Обновлённое добавление документа 
 void SearchServer::AddDocument(int document_id, const std::string_view document, DocumentStatus status, const std::vector<int>& ratings) {   
+        AddDocumentText(document_id, document, status, ratings, true);
+    }
+
+void SearchServer::AddExternalDocument(int document_id, std::string_view document, DocumentStatus status, const std::vector<int>& ratings) {
+        AddDocumentText(document_id, document, status, ratings, false);
+    }
+
+void SearchServer::AddDocumentText(int document_id, std::string_view document, DocumentStatus status, const std::vector<int>& ratings, bool copy_text) {
         if (!IsValidWord(document)) {    
             throw std::invalid_argument("Special symbol entered");   
         } else if ( document_id < 0 ) {    
@@ -21,16 +44,22 @@ void SearchServer::AddDocument(int document_id, const std::string_view document,
             throw std::invalid_argument("Existing id entered");   
         }   
    
-        auto words = SplitIntoWordsNoStop(document);
-        std::string document_string_(document);
+        auto& document_data = documents_.emplace(document_id, DocumentData{ComputeAverageRating(ratings), status, copy_text ? std::string(document) : std::string(), {}}).first->second;
+        document_data.text_ = copy_text ? std::string_view(document_data.string_) : document;//слова ссылаются на этот текст
+        const auto words = SplitIntoWordsNoStop(document_data.text_);   
         const double inv_word_count = 1.0 / words.size();   
-        documents_.emplace(document_id, DocumentData{ComputeAverageRating(ratings), status, document_string_});
-        words = SplitIntoWordsNoStop(documents_.at(document_id).string_);   
+        const size_t term_count = word_to_document_freqs_.size();
+        auto& word_freqs = documents_to_word_freqs_[document_id];//запись нужна и документу из одних стоп-слов, иначе его не удалить
         for ( auto word : words) {   
             word_to_document_freqs_[word][document_id] += inv_word_count;   
-            documents_to_word_freqs_[document_id][word] += inv_word_count;  // Добавляем в поле частоту слова по id 
+            word_freqs[word] += inv_word_count;  // Добавляем в поле частоту слова по id 
+        }
+        if (word_to_document_freqs_.size() != term_count) {
+            ResetTermDictionary();
         }
         documents_order_num.emplace(document_id);   
+        status_to_documents_[status].insert(document_id);
+        rating_to_documents_.emplace(document_data.rating, document_id);
     }  
   
 std::vector<Document> SearchServer::FindTopDocuments(std::string_view raw_query, DocumentStatus status) const {   
@@ -41,6 +70,22 @@ std::vector<Document> SearchServer::FindTopDocuments(std::string_view raw_query)
         return FindTopDocuments(std::execution::seq, raw_query, DocumentStatus::ACTUAL);   
     }   
   
+std::vector<Document> SearchServer::FindTopDocuments(std::string_view raw_query, Deadline deadline, DocumentStatus status) const {
+        return FindTopDocuments(raw_query, deadline, DocumentFilter{{status}});
+    }
+
+std::vector<Document> SearchServer::FindTopDocuments(std::string_view raw_query, Deadline deadline) const {
+        return FindTopDocuments(raw_query, deadline, DocumentStatus::ACTUAL);
+    }
+
+DocumentsPage SearchServer::FindTopDocuments(std::string_view raw_query, const PageCursor& cursor, size_t page_size, DocumentStatus status) const {
+        return FindTopDocuments(std::execution::seq, raw_query, cursor, page_size, status);
+    }
+
+DocumentsPage SearchServer::FindTopDocuments(std::string_view raw_query, const PageCursor& cursor, size_t page_size) const {
+        return FindTopDocuments(std::execution::seq, raw_query, cursor, page_size, DocumentStatus::ACTUAL);
+    }
+  
 int SearchServer::GetDocumentCount() const {   
         return static_cast<int>(documents_.size());
     }   
@@ -49,14 +94,20 @@ std::tuple<std::vector<std::string_view>, DocumentStatus> SearchServer::MatchDoc
         if ((document_id < 0) || (documents_.count(document_id) == 0)) {
             throw std::invalid_argument("Id is not found");
         }
-        Query query = ParseQuery(raw_query);   
+        return MatchDocument(ParseQuery(raw_query), document_id);
+    }
+
+std::tuple<std::vector<std::string_view>, DocumentStatus> SearchServer::MatchDocument(const Query& query, int document_id) const {
+        if ((document_id < 0) || (documents_.count(document_id) == 0)) {
+            throw std::invalid_argument("Id is not found");
+        }
         std::vector<std::string_view> matched_words;   
         for (std::string_view word : query.minus_words) {   
             if (word_to_document_freqs_.count(word) == 0) {   
                 continue;   
             }   
             if (word_to_document_freqs_.at(word).count(document_id)) {   
-                return { {}, documents_.at(document_id).status };  
+                return { std::vector<std::string_view>{}, documents_.at(document_id).status };  
             }   
         }    
         for (std::string_view word : query.plus_words) {   
@@ -80,12 +131,12 @@ std::tuple<std::vector<std::string_view>, DocumentStatus> SearchServer::MatchDoc
         }
         Query query = ParseQueryParallel(raw_query);   
         std::vector<std::string_view> matched_words;
-        auto var = documents_to_word_freqs_.at(document_id);//требует поместить в переменную для захвата в лямда-функцию
+        const auto& var = documents_to_word_freqs_.at(document_id);//по ссылке: копия словаря документа не нужна
         if (std::any_of(std::execution::par, query.minus_words.begin(),//проверка на минус-слова
                     query.minus_words.end(), [&var](std::string_view word) {
                         return var.count(word) > 0;
                     })) {
-            return { {}, documents_.at(document_id).status };
+            return { std::vector<std::string_view>{}, documents_.at(document_id).status };
         }
         matched_words.reserve(query.plus_words.size());//задаём размер вектора
         std::copy_if(std::execution::par, query.plus_words.begin(), query.plus_words.end(), std::back_inserter(matched_words), [&var] (std::string_view word) {
@@ -128,6 +179,54 @@ int SearchServer::ComputeAverageRating(const std::vector<int>& ratings) {
         return rating_sum / static_cast<int>(ratings.size());   
     }  
   
+std::optional<SearchServer::FilterCandidates> SearchServer::FindFilterCandidates(const DocumentFilter& filter, size_t longest_postings) const {
+        //на каждое слово запроса кандидаты перебираются заново, поэтому берём их, только если их немного;
+        //больше самого длинного списка слов их брать незачем — ни для одного слова они не пригодятся
+        size_t max_candidate_count = std::min(documents_.size() / 16, longest_postings);
+        std::optional<FilterCandidates> candidates;
+        if (!filter.statuses.empty()) {
+            FilterCandidates status_candidates;
+            for (const DocumentStatus status : filter.statuses) {
+                const auto it = status_to_documents_.find(status);
+                if (it != status_to_documents_.end() && !it->second.empty()) {
+                    status_candidates.status_documents.push_back(&it->second);
+                    status_candidates.count += it->second.size();
+                }
+            }
+            if (status_candidates.count <= max_candidate_count) {
+                status_candidates.rating_begin = status_candidates.rating_end = rating_to_documents_.end();
+                max_candidate_count = status_candidates.count;
+                candidates = std::move(status_candidates);
+            }
+        }
+        if (filter.min_rating != std::numeric_limits<int>::min() || filter.max_rating != std::numeric_limits<int>::max()) {
+            //размер отрезка индекса рейтинга неизвестен — считаем, пока он не превысит лучший вариант
+            FilterCandidates rating_candidates;
+            rating_candidates.rating_begin = rating_to_documents_.lower_bound({filter.min_rating, std::numeric_limits<int>::min()});
+            rating_candidates.rating_end = rating_candidates.rating_begin;
+            while (rating_candidates.rating_end != rating_to_documents_.end() && rating_candidates.rating_end->first <= filter.max_rating
+                   && rating_candidates.count <= max_candidate_count) {
+                ++rating_candidates.rating_end;
+                ++rating_candidates.count;
+            }
+            const bool is_whole_range = rating_candidates.rating_end == rating_to_documents_.end() || rating_candidates.rating_end->first > filter.max_rating;
+            if (is_whole_range && rating_candidates.count <= max_candidate_count && (!candidates || rating_candidates.count < candidates->count)) {
+                candidates = std::move(rating_candidates);
+            }
+        }
+        return candidates;
+    }
+  
+bool SearchServer::IsHigherRanked(const Document& lhs, const Document& rhs) {
+        if (std::abs(lhs.relevance - rhs.relevance) < MATH_ERROR) {
+            if (lhs.rating == rhs.rating) {
+                return lhs.id < rhs.id;
+            }
+            return lhs.rating > rhs.rating;
+        }
+        return lhs.relevance > rhs.relevance;
+    }
+  
 SearchServer::QueryWord SearchServer::ParseQueryWord(std::string_view text) const {   
         bool is_minus = false;   
         if (text[0] == '-') {   
@@ -140,37 +239,50 @@ SearchServer::QueryWord SearchServer::ParseQueryWord(std::string_view text) cons
             throw std::invalid_argument("Special symbol entered");   
         } else if (text[0] == '-') {   
             throw std::invalid_argument("More than 1 minus entered");   
+        } else if (text[0] == '*' || text[0] == '?') {//иначе пришлось бы перебрать весь словарь
+            throw std::invalid_argument("Wildcard at the start of a word");
         }   
-        return { text, is_minus, IsStopWord(text) };   
+        const bool is_pattern = text.find_first_of("*?") != text.npos;
+        return { text, is_minus, !is_pattern && IsStopWord(text), is_pattern };   
     }  
   
-SearchServer::Query SearchServer::ParseQuery(std::string_view text) const {
+SearchServer::Query SearchServer::ParseQuery(std::string_view text, bool expand_patterns) const {
         Query result;   
         for (std::string_view word : SplitIntoWords(text)) {   
             QueryWord query_word = ParseQueryWord(word);;   
             if (!query_word.is_stop) {   
-                if (query_word.is_minus) {   
+                if (query_word.is_pattern && !expand_patterns) {
+                    (query_word.is_minus ? result.minus_patterns : result.plus_patterns).push_back(query_word.data);
+                } else if (query_word.is_pattern) {
+                    ExpandQueryPattern(query_word.data, query_word.is_minus ? result.minus_words : result.plus_words,
+                        GetPatternExpansionLimit(query_word.is_minus));
+                } else if (query_word.is_minus) {   
                     result.minus_words.push_back(query_word.data);//меняем insert на push_back
                 } else {   
                     result.plus_words.push_back(query_word.data);//меняем insert на push_back
                 }   
             }   
         }
-        std::sort(result.minus_words.begin(), result.minus_words.end());//сортируем, чтобы повторяющиеся элементы шли по порядку
-        auto minus_end = std::unique(result.minus_words.begin(), result.minus_words.end());//удаляем дубликаты и возвращаем итератор на новый конец словаря
-        result.minus_words.resize(static_cast<size_t>( minus_end - result.minus_words.begin() ));//убираем пустые элементы
-        std::sort(result.plus_words.begin(), result.plus_words.end());
-        auto plus_end = std::unique(result.plus_words.begin(), result.plus_words.end());
-        result.plus_words.resize(static_cast<size_t>( plus_end - result.plus_words.begin() ));
+        RemoveDuplicateWords(result.minus_words);
+        RemoveDuplicateWords(result.plus_words);
         return result;   
     }  
+
+void SearchServer::RemoveDuplicateWords(std::vector<std::string_view>& words) {
+        std::sort(words.begin(), words.end());//сортируем, чтобы повторяющиеся элементы шли по порядку
+        auto words_end = std::unique(words.begin(), words.end());//удаляем дубликаты и возвращаем итератор на новый конец словаря
+        words.resize(static_cast<size_t>( words_end - words.begin() ));//убираем пустые элементы
+    }
   
 SearchServer::Query SearchServer::ParseQueryParallel(const std::string_view text) const {   
         Query result;   
         for (std::string_view word : SplitIntoWords(text)) {   
             QueryWord query_word = ParseQueryWord(word);;   
             if (!query_word.is_stop) {   
-                if (query_word.is_minus) {   
+                if (query_word.is_pattern) {
+                    ExpandQueryPattern(query_word.data, query_word.is_minus ? result.minus_words : result.plus_words,
+                        GetPatternExpansionLimit(query_word.is_minus));
+                } else if (query_word.is_minus) {   
                     result.minus_words.push_back(query_word.data);   
                 } else {   
                     result.plus_words.push_back(query_word.data);   
@@ -180,10 +292,51 @@ SearchServer::Query SearchServer::ParseQueryParallel(const std::string_view text
         return result;   
     } 
 
+void SearchServer::ExpandQueryPattern(std::string_view pattern, std::vector<std::string_view>& words, size_t max_expansions) const {
+        const std::string_view prefix = pattern.substr(0, pattern.find_first_of("*?"));
+        size_t expansion_count = 0;
+        GetTermDictionary()->ForEachWithPrefix(prefix, [&](std::string_view term) {
+            if (MatchesWildcard(pattern, term)) {
+                //в запрос кладём ключ индекса: term живёт только до следующего вызова
+                words.push_back(word_to_document_freqs_.find(term)->first);
+                ++expansion_count;
+            }
+            return expansion_count < max_expansions;
+        });
+    }
+
+size_t SearchServer::GetPatternExpansionLimit(bool is_minus) {
+        //исключение слова ничего не стоит при подсчёте, а урезанный минус-шаблон молча пропустил бы документы
+        return is_minus ? std::numeric_limits<size_t>::max() : MAX_PATTERN_EXPANSIONS;
+    }
+
+std::shared_ptr<const TermDictionary> SearchServer::GetTermDictionary() const {
+        auto term_dictionary = std::atomic_load(&term_dictionary_);
+        if (!term_dictionary) {
+            std::vector<std::string_view> terms;
+            terms.reserve(word_to_document_freqs_.size());
+            for (const auto& [word, _] : word_to_document_freqs_) {
+                terms.push_back(word);
+            }
+            term_dictionary = std::make_shared<const TermDictionary>(terms);
+            std::atomic_store(&term_dictionary_, term_dictionary);
+        }
+        return term_dictionary;
+    }
+
+void SearchServer::ResetTermDictionary() {
+        std::atomic_store(&term_dictionary_, std::shared_ptr<const TermDictionary>());
+    }
+
 double SearchServer::ComputeWordInverseDocumentFreq(std::string_view word) const {   
         return log(GetDocumentCount() * 1.0 / word_to_document_freqs_.at(word).size());   
     }  
  
+int SearchServer::GetDocumentFrequency(std::string_view word) const {
+        const auto it = word_to_document_freqs_.find(word);
+        return it == word_to_document_freqs_.end() ? 0 : static_cast<int>(it->second.size());
+    }
+ 
 std::set<int>::const_iterator SearchServer::begin() { 
         return documents_order_num.begin(); 
     } 
@@ -202,19 +355,10 @@ const std::map<std::string_view, double>& SearchServer::GetWordFrequencies(int d
  
 void SearchServer::RemoveDocument(const std::execution::sequenced_policy&, int document_id) { 
     if ( documents_to_word_freqs_.count(document_id) != 0 ) { 
-    documents_.erase(document_id); 
- 
-        std::set<int>::iterator position = std::find(documents_order_num.begin(), documents_order_num.end(), document_id); 
- 
-        documents_order_num.erase(position); 
- 
-    for ( auto [word, frequency] : documents_to_word_freqs_[document_id] ) { 
-            word_to_document_freqs_[word].erase(document_id); 
-            if ( word_to_document_freqs_[word].empty() ) { 
-                word_to_document_freqs_.erase(word); 
-            } 
+        for ( auto [word, frequency] : documents_to_word_freqs_.at(document_id) ) { 
+            word_to_document_freqs_.at(word).erase(document_id); 
         }     
-    documents_to_word_freqs_.erase(document_id); 
+        EraseDocumentData(document_id);
     } 
 } 
  
@@ -224,20 +368,103 @@ void SearchServer::RemoveDocument(int document_id) {
  
 void SearchServer::RemoveDocument(const std::execution::parallel_policy&, int document_id) { 
     if ( documents_to_word_freqs_.count(document_id) != 0 ) { 
-        documents_.erase(document_id); 
-        std::vector<std::string_view> words;//вектор ключей
-        const auto& var = documents_to_word_freqs_.at(document_id);
-        words.reserve(var.size());
-        std::transform(std::execution::par, var.begin(), var.end(), words.begin(), [] (const auto& word) {
+        const auto& word_freqs = documents_to_word_freqs_.at(document_id);
+        std::vector<std::string_view> words(word_freqs.size());//вектор ключей
+        std::transform(std::execution::par, word_freqs.begin(), word_freqs.end(), words.begin(), [] (const auto& word) {
             return word.first;
         } );//записываем адрес слов, встречающихся в документе
         std::for_each(std::execution::par, words.begin(), words.end(), [this, document_id] (std::string_view word) {
-            word_to_document_freqs_.at(word).erase(document_id);
+            word_to_document_freqs_.at(word).erase(document_id);//списки разных слов независимы, блокировки не нужны
         });
-        std::set<int>::iterator position = std::find(documents_order_num.begin(), documents_order_num.end(), document_id);
-        if ( position != documents_order_num.end() ) {
-        documents_order_num.erase(position); 
-        };
-        documents_to_word_freqs_.erase(document_id);
+        EraseDocumentData(document_id);
     } 
-}
\ No newline at end of file
+}
+
+void SearchServer::EraseDocumentData(int document_id) {
+    documents_order_num.erase(document_id); 
+    const DocumentData& document_data = documents_.at(document_id);
+    status_to_documents_[document_data.status].erase(document_id);
+    rating_to_documents_.erase({document_data.rating, document_id});
+    const std::string_view text = document_data.text_;
+    for ( auto [word, frequency] : documents_to_word_freqs_.at(document_id) ) { 
+        auto postings = word_to_document_freqs_.find(word);
+        if ( postings->second.empty() ) { 
+            word_to_document_freqs_.erase(postings); 
+            ResetTermDictionary();
+        } else if ( postings->first.data() >= text.data() && postings->first.data() < text.data() + text.size() ) {
+            //ключ ссылается на текст удаляемого документа — перевешиваем его на слово из оставшегося документа
+            auto node = word_to_document_freqs_.extract(postings);
+            node.key() = documents_to_word_freqs_.at(node.mapped().begin()->first).find(word)->first;
+            word_to_document_freqs_.insert(std::move(node));
+        }
+    }     
+    documents_to_word_freqs_.erase(document_id); 
+    documents_.erase(document_id);//текст удаляем последним: на него ссылаются ключи словарей
+}
+
+IndexStatistics SearchServer::GetStatistics(size_t longest_list_count) const {
+    IndexStatistics statistics;
+    statistics.document_count = documents_.size();
+    statistics.term_count = word_to_document_freqs_.size();
+    
+    using PostingListSize = std::pair<size_t, std::string_view>;
+    std::priority_queue<PostingListSize, std::vector<PostingListSize>, std::greater<>> longest_lists;//хранит только longest_list_count самых длинных
+    for ( const auto& [word, postings] : word_to_document_freqs_ ) {
+        statistics.posting_count += postings.size();
+        statistics.word_to_document_freqs_bytes += TreeNodeBytes<decltype(word_to_document_freqs_)>()
+            + postings.size() * TreeNodeBytes<std::map<int, double>>();
+        size_t bucket = 0;
+        while ( (postings.size() >> (bucket + 1)) > 0 ) {
+            ++bucket;
+        }
+        if ( statistics.posting_list_histogram.size() <= bucket ) {
+            statistics.posting_list_histogram.resize(bucket + 1);
+        }
+        ++statistics.posting_list_histogram[bucket];
+        if ( longest_list_count > 0 ) {
+            longest_lists.emplace(postings.size(), word);
+            if ( longest_lists.size() > longest_list_count ) {
+                longest_lists.pop();
+            }
+        }
+    }
+    statistics.longest_posting_lists.resize(longest_lists.size());
+    for ( auto it = statistics.longest_posting_lists.rbegin(); it != statistics.longest_posting_lists.rend(); ++it ) {
+        *it = {std::string(longest_lists.top().second), longest_lists.top().first};
+        longest_lists.pop();
+    }
+    
+    size_t document_term_count = 0;
+    for ( const auto& [document_id, word_freqs] : documents_to_word_freqs_ ) {
+        document_term_count += word_freqs.size();
+        statistics.documents_to_word_freqs_bytes += TreeNodeBytes<decltype(documents_to_word_freqs_)>()
+            + word_freqs.size() * TreeNodeBytes<std::map<std::string_view, double>>();
+    }
+    size_t document_bytes = 0;
+    for ( const auto& [document_id, document_data] : documents_ ) {
+        document_bytes += document_data.text_.size();
+        statistics.document_text_bytes += StringHeapBytes(document_data.string_);
+    }
+    if ( !documents_.empty() ) {
+        statistics.average_document_terms = document_term_count * 1.0 / documents_.size();
+        statistics.average_document_bytes = document_bytes * 1.0 / documents_.size();
+    }
+    statistics.documents_bytes = documents_.size() * TreeNodeBytes<decltype(documents_)>()
+        + documents_order_num.size() * TreeNodeBytes<decltype(documents_order_num)>();
+    
+    for ( const std::string& word : stop_words_ ) {
+        statistics.stop_words_bytes += TreeNodeBytes<decltype(stop_words_)>() + StringHeapBytes(word);
+    }
+    for ( const auto& [status, document_ids] : status_to_documents_ ) {
+        statistics.filter_index_bytes += TreeNodeBytes<decltype(status_to_documents_)>()
+            + document_ids.size() * TreeNodeBytes<std::set<int>>();
+    }
+    statistics.filter_index_bytes += rating_to_documents_.size() * TreeNodeBytes<decltype(rating_to_documents_)>();
+    if ( const auto term_dictionary = std::atomic_load(&term_dictionary_) ) {
+        statistics.term_dictionary_bytes = term_dictionary->GetByteCount();
+    }
+    
+    statistics.total_bytes = sizeof(*this) + statistics.word_to_document_freqs_bytes + statistics.documents_to_word_freqs_bytes
+        + statistics.documents_bytes + statistics.document_text_bytes + statistics.stop_words_bytes + statistics.filter_index_bytes + statistics.term_dictionary_bytes;
+    return statistics;
+}
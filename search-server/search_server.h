@@ -8,15 +8,24 @@
 #include <stdexcept>
 #include <execution>
 #include <future>
+#include <optional>
+#include <memory>
+#include <chrono>
 #include "document.h"  
 #include "string_processing.h"  
 #include "concurrent_map.h" 
+#include "index_statistics.h"
+#include "term_dictionary.h"
   
 class SearchServer {   
 public:   
        
     SearchServer() = default;  
     inline static constexpr int INVALID_DOCUMENT_ID = -1;   
+    inline static constexpr int MAX_RESULT_DOCUMENT_COUNT = 5;
+    inline static constexpr double MATH_ERROR = 1e-6;
+    inline static constexpr size_t MAX_PATTERN_EXPANSIONS = 64;//сколько слов индекса может подставиться вместо одного шаблона
+    using Deadline = std::chrono::steady_clock::time_point;
    
     template <typename StringContainer>   
     explicit SearchServer(const StringContainer& stop_words);  
@@ -27,6 +36,8 @@ public:
    
    
     void AddDocument(int document_id, std::string_view document, DocumentStatus status, const std::vector<int>& ratings);  
+    //Текст не копируется: вызывающий хранит его, пока документ не удалён из сервера
+    void AddExternalDocument(int document_id, std::string_view document, DocumentStatus status, const std::vector<int>& ratings);
    
    //Добавляем параллельные версии FindTopDocuments
     template <typename DocumentPredicate>   
@@ -42,6 +53,33 @@ public:
     template <typename ExecutionPolicy>
     std::vector<Document> FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query) const; //6 
     
+    //Вместо предиката можно передать DocumentFilter: документы, не подходящие под фильтр,
+    //отсекаются до подсчёта релевантности (в последовательных версиях)
+    
+    //Слово запроса с '*' (любые символы) или '?' (один символ), например cat*, заменяется словами индекса,
+    //подходящими под шаблон, — не более MAX_PATTERN_EXPANSIONS. Минус-шаблон исключает все подходящие слова:
+    //на подсчёт релевантности они не влияют. Шаблон не может начинаться с '*' или '?'
+    
+    //Поиск с дедлайном: по его наступлении подсчёт релевантности прерывается и возвращается то, что успели найти
+    template <typename DocumentPredicate>
+    std::vector<Document> FindTopDocuments(std::string_view raw_query, Deadline deadline, DocumentPredicate document_predicate) const;
+    std::vector<Document> FindTopDocuments(std::string_view raw_query, Deadline deadline, DocumentStatus status) const;
+    std::vector<Document> FindTopDocuments(std::string_view raw_query, Deadline deadline) const;
+    
+    //Постраничная выдача: следующие page_size документов после курсора
+    template <typename DocumentPredicate>
+    DocumentsPage FindTopDocuments(std::string_view raw_query, const PageCursor& cursor, size_t page_size, DocumentPredicate document_predicate) const;
+    template <typename ExecutionPolicy, typename DocumentPredicate>
+    DocumentsPage FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query, const PageCursor& cursor, size_t page_size, DocumentPredicate document_predicate) const;
+    
+    DocumentsPage FindTopDocuments(std::string_view raw_query, const PageCursor& cursor, size_t page_size, DocumentStatus status) const;
+    template <typename ExecutionPolicy>
+    DocumentsPage FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query, const PageCursor& cursor, size_t page_size, DocumentStatus status) const;
+    
+    DocumentsPage FindTopDocuments(std::string_view raw_query, const PageCursor& cursor, size_t page_size) const;
+    template <typename ExecutionPolicy>
+    DocumentsPage FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query, const PageCursor& cursor, size_t page_size) const;
+    
     
     int GetDocumentCount() const;  
    
@@ -60,47 +98,99 @@ public:
     void RemoveDocument(int document_id);
     void RemoveDocument(const std::execution::sequenced_policy&, int document_id);
     void RemoveDocument(const std::execution::parallel_policy&, int document_id);
+    
+    //Один проход по индексу без блокировок: нельзя вызывать одновременно с изменением сервера
+    IndexStatistics GetStatistics(size_t longest_list_count = 10) const;
+    
+    //Для ShardedSearchServer: запрос разбирается один раз на все шарды, а IDF считается по всему корпусу
+    struct Query { //Заменена на vector string_view
+        std::vector<std::string_view> plus_words;   
+        std::vector<std::string_view> minus_words;   
+        std::vector<std::string_view> plus_patterns;//заполняются, только если шаблоны не раскрываются при разборе
+        std::vector<std::string_view> minus_patterns;
+    };   
+    //без раскрытия шаблоны остаются в plus_patterns/minus_patterns: шардированный сервер раскрывает их сам по всем шардам
+    Query ParseQuery(std::string_view text, bool expand_patterns = true) const;
+    static void RemoveDuplicateWords(std::vector<std::string_view>& words);
+    //Дописывает в words не более max_expansions слов индекса, подходящих под шаблон
+    void ExpandQueryPattern(std::string_view pattern, std::vector<std::string_view>& words, size_t max_expansions) const;
+    static size_t GetPatternExpansionLimit(bool is_minus);
+    //В скольких документах встречается слово
+    int GetDocumentFrequency(std::string_view word) const;
+    //Top-K по разобранному запросу с IDF, посчитанным снаружи; в word_to_inverse_freq должны быть все слова запроса из этого сервера
+    template <typename DocumentPredicate>
+    std::vector<Document> FindTopDocuments(const Query& query, DocumentPredicate document_predicate, const std::map<std::string_view, double>& word_to_inverse_freq) const;
+    std::tuple<std::vector<std::string_view>, DocumentStatus> MatchDocument(const Query& query, int document_id) const;
+    //ограниченный top-K в порядке выдачи — в т.ч. при слиянии выдачи шардов
+    template <typename ExecutionPolicy>
+    static void KeepTopDocuments(ExecutionPolicy&& policy, std::vector<Document>& documents, size_t count);
    
 private:   
     struct DocumentData {   
         int rating;   
         DocumentStatus status;
         std::string string_;//добавлено поле хранения document как строку
+        std::string_view text_;//текст документа: string_ или внешний текст из AddExternalDocument
     };   
     const std::set<std::string, std::less<>> stop_words_;  //чтобы избавиться от создания временных объектов 
     std::map<std::string_view, std::map<int, double>> word_to_document_freqs_; 
     std::map<int, std::map<std::string_view, double>> documents_to_word_freqs_;  //Добавим контейнер с частотой слов по его id 
     std::map<int, DocumentData> documents_;   
     std::set<int> documents_order_num; // контейнер с порядковыми номерами   
+    std::map<DocumentStatus, std::set<int>> status_to_documents_;//документы по статусам — для отбора по DocumentFilter
+    std::set<std::pair<int, int>> rating_to_documents_;//пары (рейтинг, id), упорядоченные по рейтингу
+    //словарь для шаблонов строится при первом запросе с шаблоном и сбрасывается при изменении набора слов;
+    //доступ через std::atomic_load/atomic_store, т.к. его могут строить параллельные запросы
+    mutable std::shared_ptr<const TermDictionary> term_dictionary_;
    
    static bool IsValidWord(std::string_view word);  
    
+    void AddDocumentText(int document_id, std::string_view document, DocumentStatus status, const std::vector<int>& ratings, bool copy_text);
+   
    
     bool IsStopWord(std::string_view word) const;  
     std::vector<std::string_view> SplitIntoWordsNoStop(std::string_view text) const;  
    
     static int ComputeAverageRating(const std::vector<int>& ratings);  
+    //Порядок выдачи: релевантность, рейтинг, затем id — чтобы курсор однозначно задавал позицию
+    static bool IsHigherRanked(const Document& lhs, const Document& rhs);
    
     struct QueryWord {   
         std::string_view data;
         bool is_minus;   
         bool is_stop;   
+        bool is_pattern;
     };   
     //Обновлённый парсинг   
     QueryWord ParseQueryWord(std::string_view text) const;  
    
-    struct Query { //Заменена на vector string_view
-        std::vector<std::string_view> plus_words;   
-        std::vector<std::string_view> minus_words;   
-    };   
-   
-    Query ParseQuery(std::string_view text) const;
     Query ParseQueryParallel(std::string_view text) const;
+    std::shared_ptr<const TermDictionary> GetTermDictionary() const;
+    void ResetTermDictionary();
+    //Удаляет документ из всех структур, кроме списков слов — из них его убирает RemoveDocument
+    void EraseDocumentData(int document_id);
    
     double ComputeWordInverseDocumentFreq(std::string_view word) const;  
     //Добавлены последовательная и параллельная версия FindAllDocuments
     template <typename DocumentPredicate>   
     std::vector<Document> FindAllDocuments(const Query& query, DocumentPredicate document_predicate) const;  
+    //IDF передаётся снаружи: его считает сервер с дедлайном или шардированный сервер по всем шардам сразу
+    template <typename DocumentPredicate, typename InverseDocumentFreq>   
+    std::vector<Document> FindAllDocuments(const Query& query, DocumentPredicate document_predicate, InverseDocumentFreq inverse_document_freq_of, Deadline deadline = Deadline::max()) const;  
+    
+    //Фильтр применяется до подсчёта релевантности: по спискам документов со статусом или по рейтингу
+    template <typename InverseDocumentFreq>   
+    std::vector<Document> FindAllDocuments(const Query& query, const DocumentFilter& filter, InverseDocumentFreq inverse_document_freq_of, Deadline deadline = Deadline::max()) const;  
+    //Документы, среди которых фильтр ищет совпадения: списки документов нужных статусов или отрезок rating_to_documents_.
+    //Берутся из индексов как есть, без копирования
+    struct FilterCandidates {
+        std::vector<const std::set<int>*> status_documents;
+        std::set<std::pair<int, int>>::const_iterator rating_begin;
+        std::set<std::pair<int, int>>::const_iterator rating_end;
+        size_t count = 0;
+    };
+    //nullopt, если фильтр отсекает слишком мало: тогда дешевле проверять документы из списков слов
+    std::optional<FilterCandidates> FindFilterCandidates(const DocumentFilter& filter, size_t longest_postings) const;
     
     template <typename DocumentPredicate>   
     std::vector<Document> FindAllDocuments(const std::execution::sequenced_policy&,const Query& query, DocumentPredicate document_predicate) const;
@@ -125,27 +215,34 @@ private:
     
     template <typename ExecutionPolicy, typename DocumentPredicate>   
     std::vector<Document> SearchServer::FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query, DocumentPredicate document_predicate) const { //2  
-        const int MAX_RESULT_DOCUMENT_COUNT = 5;   
-        const double MATH_ERROR = 1e-6;   
-          
         Query query = ParseQuery(raw_query);   
    
         auto matched_documents = FindAllDocuments(policy, query, document_predicate);   
-   
-        std::sort(policy, matched_documents.begin(), matched_documents.end(),   
-             [&MATH_ERROR](const Document& lhs, const Document& rhs) {   
-                 if (std::abs(lhs.relevance - rhs.relevance) < MATH_ERROR) {   
-                     return lhs.rating > rhs.rating;   
-                 }   
-                     return lhs.relevance > rhs.relevance;   
-             });   
-        if (matched_documents.size() > MAX_RESULT_DOCUMENT_COUNT) {   
-            matched_documents.resize(MAX_RESULT_DOCUMENT_COUNT);   
-        }   
+        KeepTopDocuments(policy, matched_documents, MAX_RESULT_DOCUMENT_COUNT);
    
         return matched_documents;   
     }
     
+    template <typename DocumentPredicate>
+    std::vector<Document> SearchServer::FindTopDocuments(std::string_view raw_query, Deadline deadline, DocumentPredicate document_predicate) const {
+        Query query = ParseQuery(raw_query);
+        
+        auto matched_documents = FindAllDocuments(query, document_predicate, [this](std::string_view word) {
+            return ComputeWordInverseDocumentFreq(word);
+        }, deadline);
+        KeepTopDocuments(std::execution::seq, matched_documents, MAX_RESULT_DOCUMENT_COUNT);
+        
+        return matched_documents;
+    }
+    
+    template <typename DocumentPredicate>
+    std::vector<Document> SearchServer::FindTopDocuments(const Query& query, DocumentPredicate document_predicate, const std::map<std::string_view, double>& word_to_inverse_freq) const {
+        auto matched_documents = FindAllDocuments(query, document_predicate, [&word_to_inverse_freq](std::string_view word) {
+            return word_to_inverse_freq.at(word);
+        });
+        KeepTopDocuments(std::execution::seq, matched_documents, MAX_RESULT_DOCUMENT_COUNT);
+        return matched_documents;
+    }
     
     template <typename DocumentPredicate>   
     std::vector<Document> SearchServer::FindTopDocuments(std::string_view raw_query, DocumentPredicate document_predicate) const {  //1 
@@ -153,26 +250,93 @@ private:
     }
     template <typename ExecutionPolicy>
     std::vector<Document> SearchServer::FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query, DocumentStatus status) const {   
-        return FindTopDocuments(policy, raw_query, [status](int document_id, DocumentStatus document_status, int rating) {   
-                return document_status == status;   
-            });   //4
+        return FindTopDocuments(policy, raw_query, DocumentFilter{{status}});   //4
     }
     
     template <typename ExecutionPolicy>
     std::vector<Document> SearchServer::FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query) const {   
         return FindTopDocuments(policy, raw_query, DocumentStatus::ACTUAL);   //6
     }
+    
+    template <typename ExecutionPolicy, typename DocumentPredicate>
+    DocumentsPage SearchServer::FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query, const PageCursor& cursor, size_t page_size, DocumentPredicate document_predicate) const {
+        if ( page_size == 0 ) {//пустая страница не сдвигает курсор, и клиент зациклился бы
+            throw std::invalid_argument("Page size must be positive");
+        }
+        Query query = ParseQuery(raw_query);
+        
+        auto matched_documents = FindAllDocuments(policy, query, document_predicate);
+        if ( cursor.id != INVALID_DOCUMENT_ID ) {//отбрасываем документы, уже выданные на предыдущих страницах
+            const Document last{cursor.id, cursor.relevance, cursor.rating};
+            auto new_end = std::remove_if(policy, matched_documents.begin(), matched_documents.end(), [&last](const Document& document) {
+                return !IsHigherRanked(last, document);
+            });
+            matched_documents.erase(new_end, matched_documents.end());
+        }
+        DocumentsPage page;
+        page.has_next = matched_documents.size() > page_size;
+        KeepTopDocuments(policy, matched_documents, page_size);
+        if ( matched_documents.empty() ) {
+            page.next = cursor;//на пустой странице курсор остаётся на месте, а не возвращается в начало
+        } else {
+            const Document& last = matched_documents.back();
+            page.next = {last.relevance, last.rating, last.id};
+        }
+        page.documents = std::move(matched_documents);
+        return page;
+    }
+    
+    template <typename DocumentPredicate>
+    DocumentsPage SearchServer::FindTopDocuments(std::string_view raw_query, const PageCursor& cursor, size_t page_size, DocumentPredicate document_predicate) const {
+        return FindTopDocuments(std::execution::seq, raw_query, cursor, page_size, document_predicate);
+    }
+    
+    template <typename ExecutionPolicy>
+    DocumentsPage SearchServer::FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query, const PageCursor& cursor, size_t page_size, DocumentStatus status) const {
+        return FindTopDocuments(policy, raw_query, cursor, page_size, DocumentFilter{{status}});
+    }
+    
+    template <typename ExecutionPolicy>
+    DocumentsPage SearchServer::FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query, const PageCursor& cursor, size_t page_size) const {
+        return FindTopDocuments(policy, raw_query, cursor, page_size, DocumentStatus::ACTUAL);
+    }
 
+    //ограниченный top-K: полностью сортировать все совпадения не нужно
+    template <typename ExecutionPolicy>
+    void SearchServer::KeepTopDocuments(ExecutionPolicy&& policy, std::vector<Document>& documents, size_t count) {
+        const auto top_end = documents.begin() + std::min(documents.size(), count);
+        std::partial_sort(policy, documents.begin(), top_end, documents.end(), IsHigherRanked);
+        documents.erase(top_end, documents.end());
+    }
+    
     //no policy 
     template <typename DocumentPredicate>   
     std::vector<Document> SearchServer::FindAllDocuments(const Query& query, DocumentPredicate document_predicate) const {   
+        return FindAllDocuments(query, document_predicate, [this](std::string_view word) {
+            return ComputeWordInverseDocumentFreq(word);
+        });
+    }
+    
+    template <typename DocumentPredicate, typename InverseDocumentFreq>   
+    std::vector<Document> SearchServer::FindAllDocuments(const Query& query, DocumentPredicate document_predicate, InverseDocumentFreq inverse_document_freq_of, Deadline deadline) const {   
+        const size_t DEADLINE_CHECK_PERIOD = 1024;//часы опрашиваем не на каждом документе
+        const bool has_deadline = deadline != Deadline::max();
+        size_t scored_count = 0;
+        bool deadline_reached = false;
         std::map<int, double> document_to_relevance;   
         for ( auto word : query.plus_words) {   
+            if (deadline_reached) {
+                break;
+            }
             if (word_to_document_freqs_.count(word) == 0) {   
                 continue;   
             }   
-            const double inverse_document_freq = ComputeWordInverseDocumentFreq(word);   
+            const double inverse_document_freq = inverse_document_freq_of(word);   
             for (auto [document_id, term_freq] : word_to_document_freqs_.at(word)) {   
+                if (has_deadline && ++scored_count % DEADLINE_CHECK_PERIOD == 0 && std::chrono::steady_clock::now() >= deadline) {
+                    deadline_reached = true;
+                    break;
+                }
                 const auto& document_data = documents_.at(document_id);   
                 if (document_predicate(document_id, document_data.status, document_data.rating)) { 
                     document_to_relevance[document_id] += term_freq * inverse_document_freq;   
@@ -180,7 +344,7 @@ private:
             }   
         }   
    
-        for (std::string_view word : query.minus_words) {   
+        for (std::string_view word : query.minus_words) {//минус-слова учитываем всегда, даже после дедлайна   
             if (word_to_document_freqs_.count(word) == 0) {   
                 continue;   
             }   
@@ -196,6 +360,95 @@ private:
         }   
         return matched_documents;   
     }
+    template <typename InverseDocumentFreq>   
+    std::vector<Document> SearchServer::FindAllDocuments(const Query& query, const DocumentFilter& filter, InverseDocumentFreq inverse_document_freq_of, Deadline deadline) const {
+        if (filter.min_id > filter.max_id || filter.min_rating > filter.max_rating) {
+            return {};//пустой диапазон: иначе lower_bound(min_id) оказался бы за upper_bound(max_id)
+        }
+        const size_t DEADLINE_CHECK_PERIOD = 1024;
+        const bool has_deadline = deadline != Deadline::max();
+        size_t scored_count = 0;
+        bool deadline_reached = false;
+        std::map<int, double> document_to_relevance;
+        const auto add_relevance = [&](int document_id, double relevance) {
+            if (deadline_reached || (has_deadline && ++scored_count % DEADLINE_CHECK_PERIOD == 0 && std::chrono::steady_clock::now() >= deadline)) {
+                deadline_reached = true;
+                return false;
+            }
+            document_to_relevance[document_id] += relevance;
+            return true;
+        };
+        
+        size_t longest_postings = 0;
+        for ( auto word : query.plus_words) {
+            const auto word_it = word_to_document_freqs_.find(word);
+            longest_postings = std::max(longest_postings, word_it == word_to_document_freqs_.end() ? 0 : word_it->second.size());
+        }
+        const std::optional<FilterCandidates> candidates = FindFilterCandidates(filter, longest_postings);
+        const bool check_documents = !filter.statuses.empty()
+            || filter.min_rating != std::numeric_limits<int>::min() || filter.max_rating != std::numeric_limits<int>::max();
+        for ( auto word : query.plus_words) {
+            if (deadline_reached) {
+                break;
+            }
+            const auto word_it = word_to_document_freqs_.find(word);
+            if (word_it == word_to_document_freqs_.end()) {
+                continue;
+            }
+            const auto& postings = word_it->second;
+            const double inverse_document_freq = inverse_document_freq_of(word);
+            if (candidates && candidates->count < postings.size()) {
+                //кандидатов меньше, чем документов со словом, — ищем каждого кандидата в списке слова
+                const auto add_candidate = [&](int document_id) {
+                    const auto posting = postings.find(document_id);
+                    if (posting == postings.end()) {
+                        return true;
+                    }
+                    const auto& document_data = documents_.at(document_id);
+                    return !filter(document_id, document_data.status, document_data.rating)
+                        || add_relevance(document_id, posting->second * inverse_document_freq);
+                };
+                for (const std::set<int>* document_ids : candidates->status_documents) {
+                    for (auto id = document_ids->lower_bound(filter.min_id); id != document_ids->end() && *id <= filter.max_id && add_candidate(*id); ++id) {
+                    }
+                }
+                for (auto it = candidates->rating_begin; it != candidates->rating_end && add_candidate(it->second); ++it) {
+                }
+            } else {
+                //иначе проверяем статус и рейтинг каждого документа со словом
+                const auto postings_end = postings.upper_bound(filter.max_id);
+                for (auto posting = postings.lower_bound(filter.min_id); posting != postings_end; ++posting) {
+                    if (check_documents) {
+                        const auto& document_data = documents_.at(posting->first);
+                        if (!filter(posting->first, document_data.status, document_data.rating)) {
+                            continue;
+                        }
+                    }
+                    if (!add_relevance(posting->first, posting->second * inverse_document_freq)) {
+                        break;
+                    }
+                }
+            }
+        }
+        
+        for (std::string_view word : query.minus_words) {
+            const auto word_it = word_to_document_freqs_.find(word);
+            if (word_it == word_to_document_freqs_.end()) {
+                continue;
+            }
+            for (const auto [document_id, _] : word_it->second) {
+                document_to_relevance.erase(document_id);
+            }
+        }
+        
+        std::vector<Document> matched_documents;
+        for (const auto [document_id, relevance] : document_to_relevance) {
+            matched_documents.push_back(
+                {document_id, relevance, documents_.at(document_id).rating});
+        }
+        return matched_documents;
+    }
+    
     //seq
     template <typename DocumentPredicate>   
     std::vector<Document> SearchServer::FindAllDocuments(const std::execution::sequenced_policy&, const Query& query, DocumentPredicate document_predicate) const {
@@ -220,7 +473,7 @@ private:
          }   
       });
         std::for_each(std::execution::par, query.minus_words.begin(), query.minus_words.end(), [this, &document_to_relevance, &document_predicate] (std::string_view word) {//пробегаемся по - словам
-            if (word_to_document_freqs_.count(word) == 0) {   
+            if (word_to_document_freqs_.count(word) != 0) {   
                 for (const auto [document_id, _] : word_to_document_freqs_.at(word)) {//попытался сделать асинхронно, но выдаёт ошибку  
                     document_to_relevance.Erase(document_id);  
             }    
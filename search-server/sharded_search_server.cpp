@@ -0,0 +1,134 @@
+#include "sharded_search_server.h"
+
+ShardedSearchServer::ShardedSearchServer(size_t shard_count, const std::string& stop_words_text)
+        : ShardedSearchServer(shard_count, SplitIntoWords(stop_words_text))
+    {
+    }
+
+ShardedSearchServer::ShardedSearchServer(size_t shard_count, std::string_view stop_words_text)
+        : ShardedSearchServer(shard_count, SplitIntoWords(stop_words_text))
+    {
+    }
+
+void ShardedSearchServer::AddDocument(int document_id, std::string_view document, DocumentStatus status, const std::vector<int>& ratings) {
+        if ( document_id < 0 ) {//отрицательный id не отобразить на шард
+            throw std::invalid_argument("Negative id entered");
+        }
+        Shard& shard = GetShard(document_id);
+        std::unique_lock guard(shard.mutex);
+        shard.server.AddDocument(document_id, document, status, ratings);
+    }
+
+void ShardedSearchServer::AddExternalDocument(int document_id, std::string_view document, DocumentStatus status, const std::vector<int>& ratings) {
+        if ( document_id < 0 ) {
+            throw std::invalid_argument("Negative id entered");
+        }
+        Shard& shard = GetShard(document_id);
+        std::unique_lock guard(shard.mutex);
+        shard.server.AddExternalDocument(document_id, document, status, ratings);
+    }
+
+void ShardedSearchServer::RemoveDocument(int document_id) {
+        if ( document_id < 0 ) {
+            return;
+        }
+        Shard& shard = GetShard(document_id);
+        std::unique_lock guard(shard.mutex);
+        shard.server.RemoveDocument(document_id);
+    }
+
+std::vector<Document> ShardedSearchServer::FindTopDocuments(std::string_view raw_query, DocumentStatus status) const {
+        return FindTopDocuments(raw_query, DocumentFilter{{status}});
+    }
+
+std::vector<Document> ShardedSearchServer::FindTopDocuments(std::string_view raw_query) const {
+        return FindTopDocuments(raw_query, DocumentStatus::ACTUAL);
+    }
+
+std::tuple<std::vector<std::string>, DocumentStatus> ShardedSearchServer::MatchDocument(std::string_view raw_query, int document_id) const {
+        if ( document_id < 0 ) {
+            throw std::invalid_argument("Id is not found");
+        }
+        //шаблоны раскрываются по всем шардам, а сам документ живёт ровно в одном
+        const auto locks = LockAllShards();
+        std::set<std::string, std::less<>> expanded_words;
+        const SearchServer::Query query = ParseQuery(raw_query, expanded_words);
+        const auto [words, status] = GetShard(document_id).server.MatchDocument(query, document_id);
+        return { std::vector<std::string>(words.begin(), words.end()), status };
+    }
+
+std::map<std::string, double> ShardedSearchServer::GetWordFrequencies(int document_id) const {
+        if ( document_id < 0 ) {
+            return {};
+        }
+        const Shard& shard = GetShard(document_id);
+        std::shared_lock guard(shard.mutex);
+        const auto& word_frequencies = shard.server.GetWordFrequencies(document_id);
+        return { word_frequencies.begin(), word_frequencies.end() };
+    }
+
+int ShardedSearchServer::GetDocumentCount() const {
+        int document_count = 0;
+        for ( const auto& shard : shards_ ) {
+            std::shared_lock guard(shard->mutex);
+            document_count += shard->server.GetDocumentCount();
+        }
+        return document_count;
+    }
+
+size_t ShardedSearchServer::GetShardCount() const {
+        return shards_.size();
+    }
+
+size_t ShardedSearchServer::GetShardIndex(int document_id) const {
+        return static_cast<size_t>(document_id) % shards_.size();
+    }
+
+std::vector<IndexStatistics> ShardedSearchServer::GetShardStatistics(size_t longest_list_count) const {
+        std::vector<IndexStatistics> result;
+        result.reserve(shards_.size());
+        for ( const auto& shard : shards_ ) {
+            std::shared_lock guard(shard->mutex);
+            result.push_back(shard->server.GetStatistics(longest_list_count));
+        }
+        return result;
+    }
+
+SearchServer::Query ShardedSearchServer::ParseQuery(std::string_view raw_query, std::set<std::string, std::less<>>& expanded_words) const {
+        //стоп-слова у шардов общие, поэтому разбор в любом шарде одинаков
+        SearchServer::Query query = shards_.front()->server.ParseQuery(raw_query, false);
+        const auto expand = [&](const std::vector<std::string_view>& patterns, std::vector<std::string_view>& words, bool is_minus) {
+            const size_t max_expansions = SearchServer::GetPatternExpansionLimit(is_minus);
+            for ( std::string_view pattern : patterns ) {
+                //первые max_expansions слов объединения входят в первые max_expansions слов какого-то шарда
+                std::set<std::string, std::less<>> matched_words;
+                for ( const auto& shard : shards_ ) {
+                    std::vector<std::string_view> shard_words;
+                    shard->server.ExpandQueryPattern(pattern, shard_words, max_expansions);
+                    matched_words.insert(shard_words.begin(), shard_words.end());
+                }
+                auto word = matched_words.begin();
+                for ( size_t i = 0; i < max_expansions && word != matched_words.end(); ++i, ++word ) {
+                    words.push_back(*expanded_words.insert(*word).first);
+                }
+            }
+        };
+        expand(query.plus_patterns, query.plus_words, false);
+        expand(query.minus_patterns, query.minus_words, true);
+        SearchServer::RemoveDuplicateWords(query.plus_words);
+        SearchServer::RemoveDuplicateWords(query.minus_words);
+        return query;
+    }
+
+ShardedSearchServer::Shard& ShardedSearchServer::GetShard(int document_id) const {
+        return *shards_[GetShardIndex(document_id)];
+    }
+
+std::vector<std::shared_lock<std::shared_mutex>> ShardedSearchServer::LockAllShards() const {
+        std::vector<std::shared_lock<std::shared_mutex>> locks;//всегда в порядке шардов
+        locks.reserve(shards_.size());
+        for ( const auto& shard : shards_ ) {
+            locks.emplace_back(shard->mutex);
+        }
+        return locks;
+    }
@@ -0,0 +1,131 @@
+#pragma once
+#include <memory>
+#include <shared_mutex>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <set>
+#include <tuple>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include <execution>
+#include "document.h"
+#include "search_server.h"
+
+//Документы делятся по id между независимыми шардами. Запись блокирует только свой шард,
+//поиск рассылается во все шарды и сливается, IDF считается по всему корпусу
+class ShardedSearchServer {
+public:
+    template <typename StringContainer>
+    ShardedSearchServer(size_t shard_count, const StringContainer& stop_words);
+    
+    ShardedSearchServer(size_t shard_count, const std::string& stop_words_text);
+    
+    ShardedSearchServer(size_t shard_count, std::string_view stop_words_text);
+    
+    void AddDocument(int document_id, std::string_view document, DocumentStatus status, const std::vector<int>& ratings);
+    
+    //Текст не копируется, см. SearchServer::AddExternalDocument
+    void AddExternalDocument(int document_id, std::string_view document, DocumentStatus status, const std::vector<int>& ratings);
+    
+    void RemoveDocument(int document_id);
+    
+    template <typename DocumentPredicate>
+    std::vector<Document> FindTopDocuments(std::string_view raw_query, DocumentPredicate document_predicate) const;
+    
+    std::vector<Document> FindTopDocuments(std::string_view raw_query, DocumentStatus status) const;
+    
+    std::vector<Document> FindTopDocuments(std::string_view raw_query) const;
+    
+    //Слова копируются под блокировкой шарда: после её снятия шард может измениться
+    std::tuple<std::vector<std::string>, DocumentStatus> MatchDocument(std::string_view raw_query, int document_id) const;
+    
+    std::map<std::string, double> GetWordFrequencies(int document_id) const;
+    
+    int GetDocumentCount() const;
+    
+    size_t GetShardCount() const;
+    
+    size_t GetShardIndex(int document_id) const;
+    
+    std::vector<IndexStatistics> GetShardStatistics(size_t longest_list_count = 10) const;
+    
+private:
+    struct Shard {
+        template <typename StringContainer>
+        explicit Shard(const StringContainer& stop_words) : server(stop_words)
+        {
+        }
+        
+        SearchServer server;
+        mutable std::shared_mutex mutex;
+    };
+    std::vector<std::unique_ptr<Shard>> shards_;//unique_ptr — мьютекс нельзя перемещать
+    
+    Shard& GetShard(int document_id) const;
+    
+    std::vector<std::shared_lock<std::shared_mutex>> LockAllShards() const;
+    
+    //Разбирает запрос один раз для всех шардов. Шаблоны раскрываются по объединению словарей шардов
+    //с тем же ограничением числа слов, что в одиночном сервере; слова хранятся в expanded_words.
+    //Вызывать под LockAllShards
+    SearchServer::Query ParseQuery(std::string_view raw_query, std::set<std::string, std::less<>>& expanded_words) const;
+};
+
+//Реализация
+
+    template <typename StringContainer>
+    ShardedSearchServer::ShardedSearchServer(size_t shard_count, const StringContainer& stop_words) {
+        if ( shard_count == 0 ) {
+            throw std::invalid_argument("Shard count must be positive");
+        }
+        shards_.reserve(shard_count);
+        for ( size_t i = 0; i < shard_count; ++i ) {
+            shards_.push_back(std::make_unique<Shard>(stop_words));
+        }
+    }
+    
+    template <typename DocumentPredicate>
+    std::vector<Document> ShardedSearchServer::FindTopDocuments(std::string_view raw_query, DocumentPredicate document_predicate) const {
+        const auto locks = LockAllShards();//все шарды видят один и тот же снимок корпуса
+        
+        std::set<std::string, std::less<>> expanded_words;
+        const SearchServer::Query query = ParseQuery(raw_query, expanded_words);//все шарды считают по одному набору слов
+        
+        //общий IDF: число документов и документная частота слов суммируются по всем шардам
+        int document_count = 0;
+        std::map<std::string_view, int> word_to_document_count;
+        for ( size_t i = 0; i < shards_.size(); ++i ) {
+            const SearchServer& server = shards_[i]->server;
+            document_count += server.GetDocumentCount();
+            for ( std::string_view word : query.plus_words ) {
+                word_to_document_count[word] += server.GetDocumentFrequency(word);
+            }
+        }
+        std::map<std::string_view, double> word_to_inverse_freq;
+        for ( const auto [word, count] : word_to_document_count ) {
+            if ( count > 0 ) {
+                word_to_inverse_freq[word] = std::log(document_count * 1.0 / count);
+            }
+        }
+        
+        //scatter: каждый шард возвращает свой top-K, gather: сливаем их в общий top-K
+        std::vector<std::vector<Document>> shard_results(shards_.size());
+        std::vector<size_t> indexes(shards_.size());
+        for ( size_t i = 0; i < indexes.size(); ++i ) {
+            indexes[i] = i;
+        }
+        std::for_each(std::execution::par, indexes.begin(), indexes.end(), [&](size_t i) {
+            shard_results[i] = shards_[i]->server.FindTopDocuments(query, document_predicate, word_to_inverse_freq);
+        });
+        
+        std::vector<Document> result;
+        for ( auto& documents : shard_results ) {
+            result.insert(result.end(), documents.begin(), documents.end());
+        }
+        SearchServer::KeepTopDocuments(std::execution::seq, result, SearchServer::MAX_RESULT_DOCUMENT_COUNT);
+        return result;
+    }
@@ -13,4 +13,30 @@ std::vector<std::string_view> SplitIntoWords(std::string_view text) {
     } 
   
     return words;  
-}
\ No newline at end of file
+}
+
+bool MatchesWildcard(std::string_view pattern, std::string_view word) {
+    //жадное сопоставление с возвратом к последней '*'
+    size_t pattern_pos = 0;
+    size_t word_pos = 0;
+    size_t star_pos = pattern.npos;
+    size_t star_word_pos = 0;
+    while ( word_pos < word.size() ) {
+        if ( pattern_pos < pattern.size() && (pattern[pattern_pos] == '?' || pattern[pattern_pos] == word[word_pos]) ) {
+            ++pattern_pos;
+            ++word_pos;
+        } else if ( pattern_pos < pattern.size() && pattern[pattern_pos] == '*' ) {
+            star_pos = pattern_pos++;
+            star_word_pos = word_pos;
+        } else if ( star_pos != pattern.npos ) {
+            pattern_pos = star_pos + 1;
+            word_pos = ++star_word_pos;
+        } else {
+            return false;
+        }
+    }
+    while ( pattern_pos < pattern.size() && pattern[pattern_pos] == '*' ) {
+        ++pattern_pos;
+    }
+    return pattern_pos == pattern.size();
+}
@@ -3,6 +3,9 @@
 #include <vector>  
 #include <string>  
 std::vector<std::string_view> SplitIntoWords(std::string_view text); 
+
+//Шаблон: '*' — любая последовательность символов, '?' — ровно один символ
+bool MatchesWildcard(std::string_view pattern, std::string_view word);
  
 template <typename StringContainer>   
 std::set<std::string, std::less<>> MakeUniqueNonEmptyStrings(const StringContainer& strings) {   
@@ -0,0 +1,73 @@
+#include "term_dictionary.h"
+#include <algorithm>
+
+TermDictionary::TermDictionary(const std::vector<std::string_view>& sorted_terms)
+        : term_count_(sorted_terms.size()) {
+        block_offsets_.reserve(sorted_terms.size() / BLOCK_SIZE + 1);
+        std::string_view previous;
+        for ( size_t i = 0; i < sorted_terms.size(); ++i ) {
+            const std::string_view term = sorted_terms[i];
+            size_t shared_length = 0;
+            if ( i % BLOCK_SIZE == 0 ) {//первое слово блока пишется целиком
+                block_offsets_.push_back(static_cast<uint32_t>(data_.size()));
+            } else {
+                const auto mismatch = std::mismatch(previous.begin(), previous.end(), term.begin(), term.end());
+                shared_length = static_cast<size_t>(mismatch.first - previous.begin());
+            }
+            WriteLength(data_, shared_length);
+            WriteLength(data_, term.size() - shared_length);
+            data_.append(term.substr(shared_length));
+            previous = term;
+        }
+        data_.shrink_to_fit();
+    }
+
+size_t TermDictionary::GetTermCount() const {
+        return term_count_;
+    }
+
+size_t TermDictionary::GetByteCount() const {
+        return sizeof(*this) + data_.capacity() + block_offsets_.capacity() * sizeof(uint32_t);
+    }
+
+//длина записывается по 7 бит в байте, старший бит — признак продолжения
+void TermDictionary::WriteLength(std::string& data, size_t length) {
+        while ( length >= 0x80 ) {
+            data.push_back(static_cast<char>((length & 0x7F) | 0x80));
+            length >>= 7;
+        }
+        data.push_back(static_cast<char>(length));
+    }
+
+size_t TermDictionary::ReadLength(size_t& offset) const {
+        size_t length = 0;
+        for ( int shift = 0; ; shift += 7 ) {
+            const auto byte = static_cast<unsigned char>(data_[offset++]);
+            length |= static_cast<size_t>(byte & 0x7F) << shift;
+            if ( (byte & 0x80) == 0 ) {
+                return length;
+            }
+        }
+    }
+
+std::string_view TermDictionary::GetBlockFirstTerm(size_t block) const {
+        size_t offset = block_offsets_[block];
+        ReadLength(offset);//общий префикс у первого слова блока всегда нулевой
+        const size_t length = ReadLength(offset);
+        return std::string_view(data_).substr(offset, length);
+    }
+
+size_t TermDictionary::FindFirstBlock(std::string_view prefix) const {
+        //последний блок, первое слово которого не больше префикса
+        size_t left = 0;
+        size_t right = block_offsets_.size();
+        while ( left < right ) {
+            const size_t middle = left + (right - left) / 2;
+            if ( GetBlockFirstTerm(middle) <= prefix ) {
+                left = middle + 1;
+            } else {
+                right = middle;
+            }
+        }
+        return left == 0 ? 0 : left - 1;
+    }
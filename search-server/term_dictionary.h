@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//Неизменяемый словарь отсортированных слов с фронтальным сжатием. Слова хранятся блоками по BLOCK_SIZE:
+//первое слово блока целиком, остальные — длиной общего с предыдущим словом префикса и суффиксом.
+//Поиск по префиксу — двоичный поиск по первым словам блоков и последовательное чтение
+class TermDictionary {
+public:
+    TermDictionary() = default;
+    
+    //слова должны быть отсортированы и уникальны
+    explicit TermDictionary(const std::vector<std::string_view>& sorted_terms);
+    
+    //Вызывает callback(std::string_view) для слов с префиксом prefix по порядку, пока callback возвращает true.
+    //Переданный string_view действителен только до следующего вызова callback
+    template <typename Callback>
+    void ForEachWithPrefix(std::string_view prefix, Callback callback) const;
+    
+    size_t GetTermCount() const;
+    
+    size_t GetByteCount() const;
+    
+private:
+    inline static constexpr size_t BLOCK_SIZE = 16;
+    std::string data_;
+    std::vector<uint32_t> block_offsets_;
+    size_t term_count_ = 0;
+    
+    static void WriteLength(std::string& data, size_t length);
+    size_t ReadLength(size_t& offset) const;
+    std::string_view GetBlockFirstTerm(size_t block) const;
+    size_t FindFirstBlock(std::string_view prefix) const;
+};
+
+//Реализация
+
+    template <typename Callback>
+    void TermDictionary::ForEachWithPrefix(std::string_view prefix, Callback callback) const {
+        std::string term;
+        for ( size_t block = FindFirstBlock(prefix); block < block_offsets_.size(); ++block ) {
+            size_t offset = block_offsets_[block];
+            const size_t block_end = block + 1 < block_offsets_.size() ? block_offsets_[block + 1] : data_.size();
+            while ( offset < block_end ) {
+                const size_t shared_length = ReadLength(offset);
+                const size_t suffix_length = ReadLength(offset);
+                term.resize(shared_length);
+                term.append(data_, offset, suffix_length);
+                offset += suffix_length;
+                if ( term.compare(0, prefix.size(), prefix) == 0 ) {
+                    if ( !callback(std::string_view(term)) ) {
+                        return;
+                    }
+                } else if ( std::string_view(term) > prefix ) {//слова отсортированы — дальше совпадений нет
+                    return;
+                }
+            }
+        }
+    }
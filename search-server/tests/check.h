@@ -0,0 +1,36 @@
+// Общие проверки для тестов: CHECK не прерывает тест, а считает провалы — main возвращает ReportFailures
+#pragma once
+#include "search_server.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+inline int failure_count = 0;
+
+#define CHECK(condition, context)                                                     \
+    do {                                                                              \
+        if (!(condition)) {                                                           \
+            ++failure_count;                                                          \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " << #condition            \
+                      << " failed, " << (context) << std::endl;                       \
+        }                                                                             \
+    } while (false)
+
+inline void CheckSameDocuments(const std::vector<Document>& expected, const std::vector<Document>& actual, const std::string& context) {
+    CHECK(expected.size() == actual.size(), context);
+    for (size_t i = 0; i < std::min(expected.size(), actual.size()); ++i) {
+        CHECK(expected[i].id == actual[i].id, context);
+        CHECK(expected[i].rating == actual[i].rating, context);
+        CHECK(std::abs(expected[i].relevance - actual[i].relevance) < SearchServer::MATH_ERROR, context);
+    }
+}
+
+inline int ReportFailures(const std::string& test_name) {
+    if (failure_count > 0) {
+        std::cerr << test_name << ": " << failure_count << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << test_name << ": OK" << std::endl;
+    return 0;
+}
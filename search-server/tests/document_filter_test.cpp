@@ -0,0 +1,95 @@
+// DocumentFilter отбирает документы до подсчёта релевантности: выдача должна совпадать с выдачей
+// по такому же условию, переданному обычным предикатом (он проверяется уже после подсчёта)
+#include "check.h"
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std::string_literals;
+
+namespace {
+
+void TestEmptyRanges() {
+    SearchServer search_server("and"s);
+    for (int document_id = 0; document_id < 20; ++document_id) {
+        search_server.AddDocument(document_id, "cat dog "s + std::to_string(document_id), DocumentStatus::ACTUAL, {document_id});
+    }
+    DocumentFilter inverted_ids;
+    inverted_ids.min_id = 10;
+    inverted_ids.max_id = 5;
+    DocumentFilter inverted_ratings;
+    inverted_ratings.min_rating = 10;
+    inverted_ratings.max_rating = 5;
+    for (const DocumentFilter& filter : {inverted_ids, inverted_ratings}) {
+        CHECK(search_server.FindTopDocuments("cat"s, filter).empty(), "inverted range"s);
+        CHECK(search_server.FindTopDocuments("cat -dog"s, filter).empty(), "inverted range with minus-word"s);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        CHECK(search_server.FindTopDocuments("cat"s, deadline, filter).empty(), "inverted range with deadline"s);
+        const auto page = search_server.FindTopDocuments("cat"s, PageCursor{}, 5, filter);
+        CHECK(page.documents.empty() && !page.has_next, "inverted range page"s);
+    }
+}
+
+DocumentFilter MakeFilter(std::mt19937& generator, int document_count) {
+    DocumentFilter filter;
+    for (int status = 0; status < 4; ++status) {
+        if (generator() % 3 == 0) {
+            filter.statuses.insert(static_cast<DocumentStatus>(status));
+        }
+    }
+    if (generator() % 2 == 0) {
+        filter.min_rating = static_cast<int>(generator() % 20) - 5;
+    }
+    if (generator() % 2 == 0) {
+        filter.max_rating = static_cast<int>(generator() % 20) - 5;//бывает меньше min_rating
+    }
+    if (generator() % 3 == 0) {
+        filter.min_id = static_cast<int>(generator() % document_count);
+    }
+    if (generator() % 3 == 0) {
+        filter.max_id = static_cast<int>(generator() % document_count);
+    }
+    return filter;
+}
+
+void TestMatchesPredicate(std::mt19937& generator) {
+    const std::vector<std::string> vocabulary = {"cat"s, "dog"s, "bird"s, "fish"s, "mouse"s, "horse"s, "cow"s, "and"s};
+    SearchServer search_server("and"s);
+    const int document_count = 100 + generator() % 1000;
+    for (int document_id = 0; document_id < document_count; ++document_id) {
+        std::string text;
+        const int word_count = 1 + generator() % 6;
+        for (int i = 0; i < word_count; ++i) {
+            text += (i == 0 ? ""s : " "s) + vocabulary[generator() % vocabulary.size()];
+        }
+        //статусы неравномерны, чтобы встречались и редкие, и частые
+        const auto status = static_cast<DocumentStatus>(generator() % 10 == 0 ? 1 + generator() % 3 : 0);
+        search_server.AddDocument(document_id, text, status, {static_cast<int>(generator() % 20) - 5});
+    }
+    const std::vector<std::string> queries = {"cat"s, "dog bird"s, "fish -cat"s, "mouse horse cow"s, "cat dog -bird"s};
+    for (int i = 0; i < 200; ++i) {
+        const DocumentFilter filter = MakeFilter(generator, document_count);
+        const auto predicate = [&filter](int document_id, DocumentStatus status, int rating) {
+            return filter(document_id, status, rating);
+        };
+        for (const std::string& query : queries) {
+            const std::string context = "query \""s + query + "\""s;
+            CheckSameDocuments(search_server.FindTopDocuments(query, predicate), search_server.FindTopDocuments(query, filter), context);
+            const size_t all_documents = static_cast<size_t>(document_count);
+            CheckSameDocuments(search_server.FindTopDocuments(query, PageCursor{}, all_documents, predicate).documents,
+                search_server.FindTopDocuments(query, PageCursor{}, all_documents, filter).documents, context + " page"s);
+        }
+    }
+}
+
+} //namespace
+
+int main() {
+    TestEmptyRanges();
+    std::mt19937 generator(7);
+    for (int i = 0; i < 5; ++i) {
+        TestMatchesPredicate(generator);
+    }
+    return ReportFailures("document_filter_test"s);
+}
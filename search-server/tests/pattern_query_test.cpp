@@ -0,0 +1,63 @@
+// Шаблоны в запросе: плюс-шаблон раскрывается не более чем в MAX_PATTERN_EXPANSIONS слов,
+// минус-шаблон исключает документы со всеми подходящими словами
+#include "check.h"
+#include "sharded_search_server.h"
+#include <execution>
+#include <string>
+#include <vector>
+
+using namespace std::string_literals;
+
+namespace {
+
+//слов с префиксом ca больше, чем MAX_PATTERN_EXPANSIONS
+const int DOCUMENT_COUNT = 100;
+
+template <typename Server>
+void AddDocuments(Server& server) {
+    for (int document_id = 0; document_id < DOCUMENT_COUNT; ++document_id) {
+        server.AddDocument(document_id, "dog ca"s + std::to_string(document_id), DocumentStatus::ACTUAL, {1});
+    }
+}
+
+void TestMinusPatternIsNotCapped() {
+    SearchServer search_server("and"s);
+    AddDocuments(search_server);
+    CHECK(search_server.FindTopDocuments("dog -ca*"s).empty(), "minus pattern, seq"s);
+    CHECK(search_server.FindTopDocuments(std::execution::par, "dog -ca*"s).empty(), "minus pattern, par"s);
+    CHECK(search_server.FindTopDocuments("dog -ca*"s, PageCursor{}, DOCUMENT_COUNT).documents.empty(), "minus pattern, page"s);
+    for (int document_id = 0; document_id < DOCUMENT_COUNT; ++document_id) {
+        const std::string context = "MatchDocument of document "s + std::to_string(document_id);
+        CHECK(std::get<0>(search_server.MatchDocument("dog -ca*"s, document_id)).empty(), context);
+        CHECK(std::get<0>(search_server.MatchDocument(std::execution::par, "dog -ca*"s, document_id)).empty(), context + ", par"s);
+    }
+}
+
+void TestPlusPatternIsCapped() {
+    SearchServer search_server("and"s);
+    AddDocuments(search_server);
+    int matched_count = 0;
+    for (int document_id = 0; document_id < DOCUMENT_COUNT; ++document_id) {
+        matched_count += std::get<0>(search_server.MatchDocument("ca*"s, document_id)).empty() ? 0 : 1;
+    }
+    CHECK(matched_count == static_cast<int>(SearchServer::MAX_PATTERN_EXPANSIONS), "plus pattern expands to MAX_PATTERN_EXPANSIONS words"s);
+}
+
+void TestShardedMinusPattern() {
+    ShardedSearchServer search_server(4, "and"s);
+    AddDocuments(search_server);
+    CHECK(search_server.FindTopDocuments("dog -ca*"s).empty(), "sharded minus pattern"s);
+    for (int document_id = 0; document_id < DOCUMENT_COUNT; ++document_id) {
+        CHECK(std::get<0>(search_server.MatchDocument("dog -ca*"s, document_id)).empty(),
+            "sharded MatchDocument of document "s + std::to_string(document_id));
+    }
+}
+
+} //namespace
+
+int main() {
+    TestMinusPatternIsNotCapped();
+    TestPlusPatternIsCapped();
+    TestShardedMinusPattern();
+    return ReportFailures("pattern_query_test"s);
+}
@@ -0,0 +1,159 @@
+// Случайные корпуса и запросы: последовательные и параллельные версии FindTopDocuments,
+// MatchDocument и RemoveDocument должны давать одинаковый результат (релевантность — с точностью MATH_ERROR).
+// Запуск: seq_par_equivalence [число корпусов] [seed]; для проверки гонок — сборка с -DSEARCH_SERVER_TSAN=ON
+#include "check.h"
+#include <cstdlib>
+#include <execution>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std::string_literals;
+
+namespace {
+
+void CheckSameMatch(const std::tuple<std::vector<std::string_view>, DocumentStatus>& expected,
+                    const std::tuple<std::vector<std::string_view>, DocumentStatus>& actual, const std::string& context) {
+    CHECK(std::get<0>(expected) == std::get<0>(actual), context);
+    CHECK(std::get<1>(expected) == std::get<1>(actual), context);
+}
+
+struct Corpus {
+    std::vector<std::string> vocabulary;
+    std::string stop_words;
+};
+
+Corpus MakeCorpus(std::mt19937& generator) {
+    Corpus corpus;
+    const int word_count = 5 + generator() % 40;
+    for (int i = 0; i < word_count; ++i) {
+        std::string word;
+        const int length = 1 + generator() % 4;
+        for (int j = 0; j < length; ++j) {
+            word += static_cast<char>('a' + generator() % 5);
+        }
+        corpus.vocabulary.push_back(word);
+    }
+    corpus.stop_words = corpus.vocabulary[0] + " "s + corpus.vocabulary[1];
+    return corpus;
+}
+
+std::string MakeQuery(const Corpus& corpus, std::mt19937& generator) {
+    std::string query;
+    const int word_count = 1 + generator() % 5;
+    for (int i = 0; i < word_count; ++i) {
+        if (!query.empty()) {
+            query += ' ';
+        }
+        if (generator() % 4 == 0) {
+            query += '-';
+        }
+        std::string word = corpus.vocabulary[generator() % corpus.vocabulary.size()];
+        if (generator() % 6 == 0) {//шаблон
+            word = word.substr(0, 1) + "*"s;
+        }
+        query += word;
+    }
+    return query;
+}
+
+void CheckQuery(SearchServer& search_server, const std::string& query) {//begin/end у сервера неконстантные
+    const std::string context = "query \""s + query + "\""s;
+    const auto predicate = [](int document_id, DocumentStatus, int rating) {
+        return document_id % 3 == 0 || rating > 2;
+    };
+    const auto expected = search_server.FindTopDocuments(query);
+    CheckSameDocuments(expected, search_server.FindTopDocuments(std::execution::seq, query), context);
+    CheckSameDocuments(expected, search_server.FindTopDocuments(std::execution::par, query), context);
+    for (int status = 0; status < 4; ++status) {
+        const auto document_status = static_cast<DocumentStatus>(status);
+        const auto expected_status = search_server.FindTopDocuments(query, document_status);
+        CheckSameDocuments(expected_status, search_server.FindTopDocuments(std::execution::seq, query, document_status), context);
+        CheckSameDocuments(expected_status, search_server.FindTopDocuments(std::execution::par, query, document_status), context);
+    }
+    const auto expected_predicate = search_server.FindTopDocuments(query, predicate);
+    CheckSameDocuments(expected_predicate, search_server.FindTopDocuments(std::execution::seq, query, predicate), context);
+    CheckSameDocuments(expected_predicate, search_server.FindTopDocuments(std::execution::par, query, predicate), context);
+    
+    const PageCursor start;
+    const size_t all_documents = static_cast<size_t>(search_server.GetDocumentCount()) + 1;
+    const auto expected_page = search_server.FindTopDocuments(query, start, all_documents).documents;
+    CheckSameDocuments(expected_page, search_server.FindTopDocuments(std::execution::par, query, start, all_documents).documents, context);
+    CheckSameDocuments(search_server.FindTopDocuments(query, start, all_documents, predicate).documents,
+        search_server.FindTopDocuments(std::execution::par, query, start, all_documents, predicate).documents, context + " with predicate"s);
+    
+    for (const int document_id : search_server) {
+        const auto expected_match = search_server.MatchDocument(query, document_id);
+        CheckSameMatch(expected_match, search_server.MatchDocument(std::execution::seq, query, document_id), context);
+        CheckSameMatch(expected_match, search_server.MatchDocument(std::execution::par, query, document_id), context);
+    }
+}
+
+void CheckCorpus(std::mt19937& generator) {
+    const Corpus corpus = MakeCorpus(generator);
+    SearchServer sequential_server(corpus.stop_words);
+    SearchServer parallel_server(corpus.stop_words);
+    
+    const int document_count = 50 + generator() % 400;
+    for (int document_id = 0; document_id < document_count; ++document_id) {
+        std::string text;
+        const int word_count = 1 + generator() % 10;
+        for (int i = 0; i < word_count; ++i) {
+            text += (i == 0 ? ""s : " "s) + corpus.vocabulary[generator() % corpus.vocabulary.size()];
+        }
+        const auto status = static_cast<DocumentStatus>(generator() % 4);
+        std::vector<int> ratings;
+        const int rating_count = generator() % 4;
+        for (int i = 0; i < rating_count; ++i) {
+            ratings.push_back(static_cast<int>(generator() % 20) - 5);
+        }
+        sequential_server.AddDocument(document_id, text, status, ratings);
+        parallel_server.AddDocument(document_id, text, status, ratings);
+    }
+    //удаляем одни и те же документы разными версиями RemoveDocument, в т.ч. повторно
+    for (int i = 0; i < document_count / 3; ++i) {
+        const int document_id = generator() % document_count;
+        if (i % 2 == 0) {
+            sequential_server.RemoveDocument(document_id);
+        } else {
+            sequential_server.RemoveDocument(std::execution::seq, document_id);
+        }
+        parallel_server.RemoveDocument(std::execution::par, document_id);
+    }
+    CHECK(sequential_server.GetDocumentCount() == parallel_server.GetDocumentCount(), "after RemoveDocument"s);
+    for (const int document_id : sequential_server) {
+        const auto& expected = sequential_server.GetWordFrequencies(document_id);
+        const auto& actual = parallel_server.GetWordFrequencies(document_id);
+        CHECK(expected.size() == actual.size(), "word frequencies of document "s + std::to_string(document_id));
+    }
+    
+    for (int i = 0; i < 60; ++i) {
+        const std::string query = MakeQuery(corpus, generator);
+        try {
+            CheckQuery(sequential_server, query);
+            //после удаления параллельной версией индекс должен отвечать так же
+            const auto context = "removed in parallel, query \""s + query + "\""s;
+            CheckSameDocuments(sequential_server.FindTopDocuments(query), parallel_server.FindTopDocuments(query), context);
+            CheckSameDocuments(sequential_server.FindTopDocuments(query), parallel_server.FindTopDocuments(std::execution::par, query), context);
+        } catch (const std::invalid_argument&) {//некорректные запросы, например из одних минус-слов с шаблоном
+        }
+    }
+}
+
+} //namespace
+
+int main(int argc, char* argv[]) {
+    const int corpus_count = argc > 1 ? std::atoi(argv[1]) : 30;
+    const unsigned seed = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 7u;
+    std::mt19937 generator(seed);
+    for (int i = 0; i < corpus_count; ++i) {
+        CheckCorpus(generator);
+    }
+    if (failure_count > 0) {
+        std::cerr << failure_count << " checks failed (seed " << seed << ")" << std::endl;
+        return 1;
+    }
+    std::cout << "seq/par equivalence: " << corpus_count << " corpora OK (seed " << seed << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,120 @@
+// ShardedSearchServer с общим IDF должен отвечать так же, как один SearchServer с теми же документами.
+// Запуск: sharded_search_server_test [число корпусов] [seed]
+#include "check.h"
+#include "sharded_search_server.h"
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std::string_literals;
+
+namespace {
+
+std::string MakeText(const std::vector<std::string>& vocabulary, std::mt19937& generator, int max_word_count, bool allow_patterns) {
+    std::string text;
+    const int word_count = 1 + generator() % max_word_count;
+    for (int i = 0; i < word_count; ++i) {
+        std::string word = vocabulary[generator() % vocabulary.size()];
+        if (allow_patterns && generator() % 4 == 0) {
+            word = "-"s + word;
+        }
+        if (allow_patterns && generator() % 6 == 0) {
+            word = word.substr(0, word.size() - 1) + "*"s;
+        }
+        text += (i == 0 ? ""s : " "s) + word;
+    }
+    return text;
+}
+
+void CheckQuery(const SearchServer& expected_server, const ShardedSearchServer& sharded_server, const std::string& query) {
+    const std::string context = "query \""s + query + "\", "s + std::to_string(sharded_server.GetShardCount()) + " shards"s;
+    CheckSameDocuments(expected_server.FindTopDocuments(query), sharded_server.FindTopDocuments(query), context);
+    for (int status = 0; status < 4; ++status) {
+        const auto document_status = static_cast<DocumentStatus>(status);
+        CheckSameDocuments(expected_server.FindTopDocuments(query, document_status),
+            sharded_server.FindTopDocuments(query, document_status), context + ", status "s + std::to_string(status));
+    }
+    const auto predicate = [](int document_id, DocumentStatus, int rating) {
+        return document_id % 3 == 0 || rating > 2;
+    };
+    CheckSameDocuments(expected_server.FindTopDocuments(query, predicate), sharded_server.FindTopDocuments(query, predicate), context + ", predicate"s);
+}
+
+void CheckCorpus(std::mt19937& generator) {
+    std::vector<std::string> vocabulary;
+    const int vocabulary_size = 5 + generator() % 80;
+    for (int i = 0; i < vocabulary_size; ++i) {
+        std::string word;
+        const int length = 2 + generator() % 3;
+        for (int j = 0; j < length; ++j) {
+            word += static_cast<char>('a' + generator() % 6);
+        }
+        vocabulary.push_back(word);
+    }
+    const std::string stop_words = vocabulary[0];
+    SearchServer expected_server(stop_words);
+    ShardedSearchServer sharded_server(1 + generator() % 5, stop_words);
+
+    const int document_count = 20 + generator() % 300;
+    for (int document_id = 0; document_id < document_count; ++document_id) {
+        const std::string text = MakeText(vocabulary, generator, 8, false);
+        const auto status = static_cast<DocumentStatus>(generator() % 4);
+        const std::vector<int> ratings = {static_cast<int>(generator() % 10) - 3};
+        expected_server.AddDocument(document_id, text, status, ratings);
+        sharded_server.AddDocument(document_id, text, status, ratings);
+    }
+    for (int i = 0; i < document_count / 4; ++i) {
+        const int document_id = generator() % document_count;
+        expected_server.RemoveDocument(document_id);
+        sharded_server.RemoveDocument(document_id);
+    }
+    CHECK(expected_server.GetDocumentCount() == sharded_server.GetDocumentCount(), "document count"s);
+
+    for (int document_id = 0; document_id < document_count; ++document_id) {
+        const auto& expected = expected_server.GetWordFrequencies(document_id);
+        const std::map<std::string, double> expected_copy(expected.begin(), expected.end());
+        CHECK(expected_copy == sharded_server.GetWordFrequencies(document_id), "word frequencies of document "s + std::to_string(document_id));
+    }
+
+    for (int i = 0; i < 40; ++i) {
+        const std::string query = MakeText(vocabulary, generator, 4, true);
+        bool expected_throws = false;
+        try {
+            expected_server.FindTopDocuments(query);
+        } catch (const std::invalid_argument&) {//некорректный запрос
+            expected_throws = true;
+        }
+        if (expected_throws) {
+            bool sharded_throws = false;
+            try {
+                sharded_server.FindTopDocuments(query);
+            } catch (const std::invalid_argument&) {
+                sharded_throws = true;
+            }
+            CHECK(sharded_throws, "invalid query \""s + query + "\""s);
+            continue;
+        }
+        CheckQuery(expected_server, sharded_server, query);
+        for (const int document_id : expected_server) {
+            const auto [expected_words, expected_status] = expected_server.MatchDocument(query, document_id);
+            const auto [words, status] = sharded_server.MatchDocument(query, document_id);
+            CHECK(std::vector<std::string>(expected_words.begin(), expected_words.end()) == words && expected_status == status,
+                "MatchDocument of document "s + std::to_string(document_id) + ", query \""s + query + "\""s);
+        }
+    }
+}
+
+} //namespace
+
+int main(int argc, char* argv[]) {
+    const int corpus_count = argc > 1 ? std::atoi(argv[1]) : 30;
+    const unsigned seed = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 7u;
+    std::mt19937 generator(seed);
+    for (int i = 0; i < corpus_count; ++i) {
+        CheckCorpus(generator);
+    }
+    return ReportFailures("sharded_search_server_test"s);
+}
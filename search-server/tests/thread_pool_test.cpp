@@ -0,0 +1,140 @@
+// Порядок выполнения задач ThreadPool и отказ в приёме задач при заполненной очереди
+#include "check.h"
+#include "thread_pool.h"
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std::string_literals;
+
+namespace {
+
+//Занимает один поток пула, пока не вызван Release: задачи, поставленные в это время, копятся в очередях
+class PoolBlocker {
+public:
+    explicit PoolBlocker(ThreadPool& pool) {
+        auto started = started_.get_future();
+        blocked_ = pool.Submit([this, release = release_.get_future()] {
+            started_.set_value();
+            release.wait();
+        });
+        started.wait();
+    }
+
+    void Release() {
+        release_.set_value();
+        blocked_.get();
+    }
+
+private:
+    std::promise<void> started_;
+    std::promise<void> release_;
+    std::future<void> blocked_;
+};
+
+class StartOrder {
+public:
+    void Record(const std::string& name) {
+        std::lock_guard guard(m_);
+        names_.push_back(name);
+    }
+
+    std::vector<std::string> Get() {
+        std::lock_guard guard(m_);
+        return names_;
+    }
+
+private:
+    std::mutex m_;
+    std::vector<std::string> names_;
+};
+
+void TestSingleThreadOrder() {
+    ThreadPool pool(1, 100);
+    StartOrder order;
+    std::vector<std::future<void>> results;
+    {
+        PoolBlocker blocker(pool);
+        for (int i = 0; i < 5; ++i) {
+            results.push_back(pool.Submit([&order, i] { order.Record("N"s + std::to_string(i)); }));
+        }
+        results.push_back(pool.Submit([&order] { order.Record("HIGH"s); }, ThreadPool::Priority::HIGH));
+        results.push_back(pool.Submit([&order] { order.Record("N5"s); }));
+        blocker.Release();
+    }
+    for (auto& result : results) {
+        result.get();
+    }
+    const std::vector<std::string> expected = {"HIGH"s, "N0"s, "N1"s, "N2"s, "N3"s, "N4"s, "N5"s};
+    CHECK(order.Get() == expected, "one thread runs HIGH first, then NORMAL in submission order"s);
+}
+
+void TestOrderWhenStealing() {
+    //один поток занят до конца, и второй забирает все задачи, в т.ч. из очереди первого
+    ThreadPool pool(2, 100);
+    for (int high_position = 0; high_position <= 6; ++high_position) {
+        StartOrder order;
+        std::vector<std::future<void>> results;
+        PoolBlocker busy(pool);
+        PoolBlocker stealing(pool);
+        std::vector<std::string> expected = {"HIGH"s};
+        for (int i = 0; i < 6; ++i) {
+            if (i == high_position) {
+                results.push_back(pool.Submit([&order] { order.Record("HIGH"s); }, ThreadPool::Priority::HIGH));
+            }
+            results.push_back(pool.Submit([&order, i] { order.Record("N"s + std::to_string(i)); }));
+            expected.push_back("N"s + std::to_string(i));
+        }
+        if (high_position == 6) {
+            results.push_back(pool.Submit([&order] { order.Record("HIGH"s); }, ThreadPool::Priority::HIGH));
+        }
+        stealing.Release();
+        for (auto& result : results) {
+            result.get();
+        }
+        busy.Release();
+        CHECK(order.Get() == expected, "HIGH submitted after "s + std::to_string(high_position) + " NORMAL tasks"s);
+    }
+}
+
+void TestRejectsWhenSaturated() {
+    ThreadPool pool(1, 3);
+    std::vector<std::future<int>> results;
+    {
+        PoolBlocker blocker(pool);
+        for (int i = 0; i < 3; ++i) {
+            results.push_back(pool.Submit([i] { return i; }));
+        }
+        CHECK(pool.GetQueuedTaskCount() == 3, "queued task count"s);
+        bool rejected = false;
+        try {
+            pool.Submit([] { return -1; });
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        CHECK(rejected, "NORMAL task over the limit is rejected"s);
+        rejected = false;
+        try {
+            pool.Submit([] { return -1; }, ThreadPool::Priority::HIGH);
+        } catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        CHECK(rejected, "HIGH task over the limit is rejected"s);
+        CHECK(pool.GetQueuedTaskCount() == 3, "rejected tasks are not counted"s);
+        blocker.Release();
+    }
+    for (int i = 0; i < 3; ++i) {
+        CHECK(results[i].get() == i, "accepted tasks still run"s);
+    }
+    CHECK(pool.Submit([] { return 7; }).get() == 7, "pool accepts tasks again after the queue drains"s);
+}
+
+} //namespace
+
+int main() {
+    TestSingleThreadOrder();
+    TestOrderWhenStealing();
+    TestRejectsWhenSaturated();
+    return ReportFailures("thread_pool_test"s);
+}
@@ -0,0 +1,98 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t thread_count, size_t max_queued_tasks)
+        : queues_(thread_count)
+        , max_queued_tasks_(max_queued_tasks) {
+        if ( thread_count == 0 ) {
+            throw std::invalid_argument("Thread count must be positive");
+        }
+        workers_.reserve(thread_count);
+        for ( size_t i = 0; i < thread_count; ++i ) {
+            workers_.emplace_back([this] { WorkerLoop(); });
+        }
+    }
+
+ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard guard(wake_mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for ( auto& worker : workers_ ) {
+            worker.join();
+        }
+    }
+
+size_t ThreadPool::GetThreadCount() const {
+        return workers_.size();
+    }
+
+size_t ThreadPool::GetQueuedTaskCount() const {
+        return queued_tasks_.load();
+    }
+
+void ThreadPool::Push(std::function<void()> task, Priority priority) {
+        if ( queued_tasks_.fetch_add(1) >= max_queued_tasks_ ) {//контроль допуска
+            queued_tasks_.fetch_sub(1);
+            throw std::runtime_error("Thread pool queue is saturated");
+        }
+        if ( priority == Priority::HIGH ) {
+            std::lock_guard guard(high_priority_tasks_.m);
+            high_priority_tasks_.tasks.push_back({0, std::move(task)});
+        } else {
+            const size_t number = next_push_.fetch_add(1);
+            auto& queue = queues_[number % queues_.size()];
+            std::lock_guard guard(queue.m);
+            queue.tasks.push_back({number, std::move(task)});
+        }
+        {
+            std::lock_guard guard(wake_mutex_);//без захвата мьютекса поток может пропустить уведомление
+        }
+        wake_.notify_one();
+    }
+
+bool ThreadPool::TryPop(std::function<void()>& task) {
+        {
+            std::lock_guard guard(high_priority_tasks_.m);
+            if ( !high_priority_tasks_.tasks.empty() ) {
+                task = std::move(high_priority_tasks_.tasks.front().function);
+                high_priority_tasks_.tasks.pop_front();
+                queued_tasks_.fetch_sub(1);
+                return true;
+            }
+        }
+        //задачи берутся с начала очередей: самый старый запрос ближе всех к дедлайну.
+        //Очередь с ним пуста, только если его уже забрал другой поток или он ещё кладётся, — тогда берём следующий
+        const size_t start = next_pop_.load();
+        for ( size_t i = 0; i < queues_.size(); ++i ) {
+            auto& queue = queues_[(start + i) % queues_.size()];
+            std::lock_guard guard(queue.m);
+            if ( queue.tasks.empty() ) {
+                continue;
+            }
+            const size_t number = queue.tasks.front().number;
+            task = std::move(queue.tasks.front().function);
+            queue.tasks.pop_front();
+            queued_tasks_.fetch_sub(1);
+            next_pop_.store(number + 1);
+            return true;
+        }
+        return false;
+    }
+
+void ThreadPool::WorkerLoop() {
+        while ( true ) {
+            std::function<void()> task;
+            if ( TryPop(task) ) {
+                task();
+                continue;
+            }
+            std::unique_lock lock(wake_mutex_);
+            if ( stopping_ && queued_tasks_.load() == 0 ) {
+                return;
+            }
+            wake_.wait(lock, [this] {
+                return stopping_ || queued_tasks_.load() > 0;
+            });
+        }
+    }
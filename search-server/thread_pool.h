@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+//Пул потоков для запросов: задачи раскладываются по кругу в очереди по числу потоков (чтобы потоки меньше
+//конкурировали за мьютекс) и забираются в том же порядке — первым выполняется самый старый запрос.
+//Число задач в очередях ограничено — при переполнении Submit бросает исключение, а не копит задержку
+class ThreadPool {
+public:
+    enum class Priority {
+        NORMAL,
+        HIGH //отдельная очередь, которую потоки проверяют раньше остальных
+    };
+    
+    ThreadPool(size_t thread_count, size_t max_queued_tasks);
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    ~ThreadPool();
+    
+    template <typename Function>
+    std::future<std::invoke_result_t<std::decay_t<Function>>> Submit(Function&& function, Priority priority = Priority::NORMAL);
+    
+    size_t GetThreadCount() const;
+    
+    size_t GetQueuedTaskCount() const;
+    
+private:
+    struct Task {
+        size_t number;//порядковый номер NORMAL задачи: по нему задача кладётся в очередь и ищется следующая
+        std::function<void()> function;
+    };
+    struct TaskQueue {
+        std::mutex m;
+        std::deque<Task> tasks;
+    };
+    TaskQueue high_priority_tasks_;
+    std::vector<TaskQueue> queues_;
+    std::vector<std::thread> workers_;
+    const size_t max_queued_tasks_;
+    std::atomic<size_t> queued_tasks_{0};
+    std::atomic<size_t> next_push_{0};
+    std::atomic<size_t> next_pop_{0};//номер самой старой задачи, которую ещё не забрали, — с её очереди начинается поиск
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    
+    void Push(std::function<void()> task, Priority priority);
+    bool TryPop(std::function<void()>& task);
+    void WorkerLoop();
+};
+
+//Реализация
+
+    template <typename Function>
+    std::future<std::invoke_result_t<std::decay_t<Function>>> ThreadPool::Submit(Function&& function, Priority priority) {
+        using Result = std::invoke_result_t<std::decay_t<Function>>;
+        //std::function требует копируемости, поэтому packaged_task хранится через shared_ptr
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(function));
+        auto result = task->get_future();
+        Push([task] { (*task)(); }, priority);
+        return result;
+    }